@@ -0,0 +1,396 @@
+//==========================================================
+// Bitboard header
+// Bit mask board representation and move generation
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "models.hpp"
+
+#include <array>
+#include <bit>      // std::popcount, std::countr_zero, std::countl_zero
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <type_traits>
+#include <utility>  // std::index_sequence, std::swap
+
+namespace othello
+{
+/// One bit per board square, indexed row by row as `y * size + x`.
+/// A single 64-bit word fits every board up to 8x8.
+using Bitboard64 = uint64_t;
+
+/// Two-word bitboard for boards with more than 64 squares (9x9 and 10x10).
+///
+/// Bit `i` is stored in `low` for `i < 64` and in `high` otherwise.
+struct Bitboard128 {
+    constexpr Bitboard128() = default;
+    constexpr Bitboard128(const uint64_t low, const uint64_t high) : low(low), high(high) {}
+
+    bool operator==(const Bitboard128& other) const = default;
+
+    constexpr Bitboard128 operator~() const
+    {
+        return {~low, ~high};
+    }
+    constexpr Bitboard128 operator&(const Bitboard128& other) const
+    {
+        return {low & other.low, high & other.high};
+    }
+    constexpr Bitboard128 operator|(const Bitboard128& other) const
+    {
+        return {low | other.low, high | other.high};
+    }
+    constexpr Bitboard128 operator^(const Bitboard128& other) const
+    {
+        return {low ^ other.low, high ^ other.high};
+    }
+    constexpr Bitboard128& operator&=(const Bitboard128& other)
+    {
+        low &= other.low;
+        high &= other.high;
+        return *this;
+    }
+    constexpr Bitboard128& operator|=(const Bitboard128& other)
+    {
+        low |= other.low;
+        high |= other.high;
+        return *this;
+    }
+    constexpr Bitboard128& operator^=(const Bitboard128& other)
+    {
+        low ^= other.low;
+        high ^= other.high;
+        return *this;
+    }
+    /// Shift towards higher indices. Shift amount must be in range 1..63.
+    constexpr Bitboard128 operator<<(const int shift) const
+    {
+        return {low << shift, (high << shift) | (low >> (64 - shift))};
+    }
+    /// Shift towards lower indices. Shift amount must be in range 1..63.
+    constexpr Bitboard128 operator>>(const int shift) const
+    {
+        return {(low >> shift) | (high << (64 - shift)), high >> shift};
+    }
+
+    uint64_t low {0};
+    uint64_t high {0};
+};
+
+/// Number of set bits (disks or squares) in the bitboard.
+[[nodiscard]] constexpr size_t count(const Bitboard64 bits)
+{
+    return static_cast<size_t>(std::popcount(bits));
+}
+
+/// Number of set bits (disks or squares) in the bitboard.
+[[nodiscard]] constexpr size_t count(const Bitboard128 bits)
+{
+    return static_cast<size_t>(std::popcount(bits.low) + std::popcount(bits.high));
+}
+
+/// Board index of the lowest set bit. The bitboard must not be empty.
+[[nodiscard]] constexpr size_t lowest_index(const Bitboard64 bits)
+{
+    return static_cast<size_t>(std::countr_zero(bits));
+}
+
+/// Board index of the lowest set bit. The bitboard must not be empty.
+[[nodiscard]] constexpr size_t lowest_index(const Bitboard128 bits)
+{
+    return bits.low != 0 ? static_cast<size_t>(std::countr_zero(bits.low))
+                         : 64 + static_cast<size_t>(std::countr_zero(bits.high));
+}
+
+/// Board index of the highest set bit. The bitboard must not be empty.
+[[nodiscard]] constexpr size_t highest_index(const Bitboard64 bits)
+{
+    return 63 - static_cast<size_t>(std::countl_zero(bits));
+}
+
+/// Board index of the highest set bit. The bitboard must not be empty.
+[[nodiscard]] constexpr size_t highest_index(const Bitboard128 bits)
+{
+    return bits.high != 0 ? 127 - static_cast<size_t>(std::countl_zero(bits.high))
+                          : 63 - static_cast<size_t>(std::countl_zero(bits.low));
+}
+
+/// Bitboard with only the given square index set.
+template<typename Bits>
+[[nodiscard]] constexpr Bits square_bit(const size_t index)
+{
+    if constexpr (std::is_same_v<Bits, Bitboard128>) {
+        return index < 64 ? Bitboard128 {uint64_t {1} << index, 0}
+                          : Bitboard128 {0, uint64_t {1} << (index - 64)};
+    } else {
+        return Bits {1} << index;
+    }
+}
+
+/// Clear the lowest set bit and return its board index. The bitboard must not be empty.
+template<typename Bits>
+constexpr size_t pop_lowest(Bits& bits)
+{
+    const size_t index = lowest_index(bits);
+    bits ^= square_bit<Bits>(index);
+    return index;
+}
+
+/// Returns true if any bit is set.
+template<typename Bits>
+[[nodiscard]] constexpr bool any(const Bits bits)
+{
+    return bits != Bits {};
+}
+
+/// Convert a bitboard to the widest bitboard type.
+[[nodiscard]] constexpr Bitboard128 widen(const Bitboard64 bits)
+{
+    return {bits, 0};
+}
+
+/// Convert a bitboard to the widest bitboard type.
+[[nodiscard]] constexpr Bitboard128 widen(const Bitboard128 bits)
+{
+    return bits;
+}
+
+/// Convert a widened bitboard back to the given bitboard type.
+template<typename Bits>
+[[nodiscard]] constexpr Bits narrow(const Bitboard128 bits)
+{
+    if constexpr (std::is_same_v<Bits, Bitboard64>) {
+        return bits.low;
+    } else {
+        return bits;
+    }
+}
+
+/// Smallest bitboard type that has a bit for every square of an N x N board.
+template<size_t N>
+using BitsFor = std::conditional_t<(N * N <= 64), Bitboard64, Bitboard128>;
+
+/// Call the given function once for each direction index as a compile-time constant.
+template<typename F>
+constexpr void for_each_direction(F&& function)
+{
+    [&]<size_t... Direction>(std::index_sequence<Direction...>) {
+        (function(std::integral_constant<size_t, Direction> {}), ...);
+    }(std::make_index_sequence<STEP_DIRECTIONS.size()> {});
+}
+
+/// Compile-time shift amounts, edge masks, rays and index maps for an N x N board.
+///
+/// Direction indices match the order of `STEP_DIRECTIONS`.
+template<size_t N>
+struct BoardGeometry {
+    using Bits = BitsFor<N>;
+
+    static constexpr size_t SIZE = N;
+    static constexpr size_t SQUARES = N * N;
+
+    /// Check that the given coordinates are inside the board.
+    static constexpr bool check_coordinates(const int x, const int y)
+    {
+        return 0 <= x && x < static_cast<int>(N) && 0 <= y && y < static_cast<int>(N);
+    }
+
+    /// Mask with every square of the board set.
+    static constexpr Bits FULL = [] {
+        Bits full {};
+        for (size_t index = 0; index < SQUARES; ++index) {
+            full |= square_bit<Bits>(index);
+        }
+        return full;
+    }();
+
+    /// Index offset for one step in each direction.
+    static constexpr std::array<int, 8> DELTAS = [] {
+        std::array<int, 8> deltas {};
+        for (size_t direction = 0; direction < STEP_DIRECTIONS.size(); ++direction) {
+            const auto [x, y] = STEP_DIRECTIONS[direction];
+            deltas[direction] = y * static_cast<int>(N) + x;
+        }
+        return deltas;
+    }();
+
+    /// Squares that remain valid after a shift in each direction.
+    /// A step to the right must not wrap onto the first column of the next row,
+    /// and a step to the left must not wrap onto the last column of the previous row.
+    static constexpr std::array<Bits, 8> MASKS = [] {
+        Bits first_column {};
+        Bits last_column {};
+        for (size_t row = 0; row < N; ++row) {
+            first_column |= square_bit<Bits>(row * N);
+            last_column |= square_bit<Bits>(row * N + N - 1);
+        }
+        std::array<Bits, 8> masks {};
+        for (size_t direction = 0; direction < STEP_DIRECTIONS.size(); ++direction) {
+            const int x = STEP_DIRECTIONS[direction].x;
+            if (x > 0) {
+                masks[direction] = FULL & ~first_column;
+            } else if (x < 0) {
+                masks[direction] = FULL & ~last_column;
+            } else {
+                masks[direction] = FULL;
+            }
+        }
+        return masks;
+    }();
+
+    /// All squares from each square to the board edge in each direction, excluding the start.
+    static constexpr std::array<std::array<Bits, 8>, SQUARES> RAYS = [] {
+        std::array<std::array<Bits, 8>, SQUARES> rays {};
+        for (size_t index = 0; index < SQUARES; ++index) {
+            for (size_t direction = 0; direction < STEP_DIRECTIONS.size(); ++direction) {
+                const auto [step_x, step_y] = STEP_DIRECTIONS[direction];
+                int x = static_cast<int>(index % N) + step_x;
+                int y = static_cast<int>(index / N) + step_y;
+                while (check_coordinates(x, y)) {
+                    rays[index][direction] |= square_bit<Bits>(
+                        static_cast<size_t>(y) * N + static_cast<size_t>(x)
+                    );
+                    x += step_x;
+                    y += step_y;
+                }
+            }
+        }
+        return rays;
+    }();
+
+    /// Square coordinates for each board index.
+    static constexpr std::array<Square, SQUARES> INDEX_SQUARES = [] {
+        std::array<Square, SQUARES> squares {};
+        for (size_t index = 0; index < SQUARES; ++index) {
+            squares[index] = Square {static_cast<int>(index % N), static_cast<int>(index / N)};
+        }
+        return squares;
+    }();
+
+    /// Number of board symmetries: four rotations, each with and without mirroring.
+    static constexpr unsigned SYMMETRIES = 8;
+
+    /// Map a board index through one of the board symmetries:
+    /// bit 0 transposes, bit 1 mirrors horizontally and bit 2 mirrors vertically.
+    static constexpr size_t transform(const size_t index, const unsigned symmetry)
+    {
+        size_t x = index % N;
+        size_t y = index / N;
+        if (symmetry & 1U) {
+            std::swap(x, y);
+        }
+        if (symmetry & 2U) {
+            x = N - 1 - x;
+        }
+        if (symmetry & 4U) {
+            y = N - 1 - y;
+        }
+        return y * N + x;
+    }
+
+    /// Symmetry that undoes the given symmetry.
+    /// Mirroring before a transpose is the same as the other mirror after it.
+    static constexpr unsigned inverse(const unsigned symmetry)
+    {
+        if (symmetry & 1U) {
+            return 1U | ((symmetry & 2U) << 1) | ((symmetry & 4U) >> 1);
+        }
+        return symmetry;
+    }
+
+    /// Map every set square through one of the board symmetries.
+    static constexpr Bits transform_bits(Bits bits, const unsigned symmetry)
+    {
+        Bits result {};
+        while (any(bits)) {
+            result |= square_bit<Bits>(transform(pop_lowest(bits), symmetry));
+        }
+        return result;
+    }
+
+    /// Move all bits one step in the given direction, dropping bits that leave the board.
+    template<size_t Direction>
+    static constexpr Bits shift(const Bits bits)
+    {
+        constexpr int delta = DELTAS[Direction];
+        if constexpr (delta > 0) {
+            return (bits << delta) & MASKS[Direction];
+        } else {
+            return (bits >> -delta) & MASKS[Direction];
+        }
+    }
+
+    /// Returns a mask of all empty squares where placing an own disk flips an opponent disk.
+    static constexpr Bits legal_moves(const Bits own, const Bits opponent)
+    {
+        const Bits empty = FULL & ~(own | opponent);
+        Bits moves {};
+        for_each_direction([&](auto direction) {
+            constexpr size_t D = decltype(direction)::value;
+            // Grow lines of opponent disks starting next to own disks.
+            // A line can contain at most `N - 2` opponent disks.
+            Bits line = shift<D>(own) & opponent;
+            for (size_t i = 2; i < N - 1; ++i) {
+                line |= shift<D>(line) & opponent;
+            }
+            moves |= shift<D>(line) & empty;
+        });
+        return moves;
+    }
+
+    /// Returns the opponent disks flipped along one direction from the given index.
+    template<size_t Direction>
+    static constexpr Bits flips_in_direction(
+        const Bits own,
+        const Bits opponent,
+        const size_t index
+    )
+    {
+        const Bits ray = RAYS[index][Direction];
+        // First square along the ray that is not an opponent disk
+        const Bits blockers = ray & ~opponent;
+        if (!any(blockers)) {
+            return {};
+        }
+        const size_t first
+            = DELTAS[Direction] > 0 ? lowest_index(blockers) : highest_index(blockers);
+        const Bits first_bit = square_bit<Bits>(first);
+        // Line of opponent disks needs to end with an own disk
+        if (!any(own & first_bit)) {
+            return {};
+        }
+        return ray & ~RAYS[first][Direction] & ~first_bit;
+    }
+
+    /// Returns the opponent disks flipped along one direction from the given index.
+    static constexpr Bits flips_in_direction(
+        const Bits own,
+        const Bits opponent,
+        const size_t index,
+        const size_t direction
+    )
+    {
+        Bits line {};
+        for_each_direction([&](auto step) {
+            constexpr size_t D = decltype(step)::value;
+            if (D == direction) {
+                line = flips_in_direction<D>(own, opponent, index);
+            }
+        });
+        return line;
+    }
+
+    /// Returns the opponent disks that placing an own disk at the given index would flip.
+    static constexpr Bits flips(const Bits own, const Bits opponent, const size_t index)
+    {
+        Bits flipped {};
+        for_each_direction([&](auto direction) {
+            flipped |= flips_in_direction<decltype(direction)::value>(own, opponent, index);
+        });
+        return flipped;
+    }
+};
+
+}  // namespace othello
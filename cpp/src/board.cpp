@@ -8,34 +8,94 @@
 #include "board.hpp"
 
 #include "colorprint.hpp"
+#include "evaluation.hpp"
 
-#include <algorithm>  // std::ranges::sort, std::ranges::transform
-#include <numeric>    // std::accumulate, std::iota
-#include <ranges>     // std::ranges::transform (requires C++20)
-#include <stdexcept>  // exceptions
+#include <algorithm>    // std::ranges::sort
+#include <numeric>      // std::iota
+#include <stdexcept>    // exceptions
+#include <type_traits>  // std::remove_cvref_t
 
 namespace othello
 {
 /// Initialize a new board for the given board size.
-Board::Board(const size_t size) :
-    board(init_board(size)),
-    // Keep track of empty squares on board to avoid checking already filled positions.
-    empty_squares(init_empty_squares(size, board)),
-    indices(size),
-    size(size)
+Board::Board(const size_t size) : board(init_board(size)), indices(size), size(size)
 {
     // Index list (0...size) to avoid repeating same range in loops.
     std::iota(indices.begin(), indices.end(), 0);
 }
 
+/// Create a board from a position string.
+///
+/// The position is the side to move, a colon, and one character per square row by row
+/// in the same format as the game log board: `B`, `W` or `_` for an empty square.
+/// For example `B:____BBB__BW_____` is a 4x4 board with black to move.
+Board Board::from_position(const std::string_view position)
+{
+    const auto separator = position.find(':');
+    if (separator != 1 || (position[0] != 'B' && position[0] != 'W')) {
+        throw std::invalid_argument(
+            fmt::format("Position must start with the side to move (B: or W:): {}", position)
+        );
+    }
+    const std::string_view disks = position.substr(2);
+    size_t size = MIN_BOARD_SIZE;
+    while (size < MAX_BOARD_SIZE && size * size < disks.size()) {
+        ++size;
+    }
+    if (size * size != disks.size()) {
+        throw std::invalid_argument(
+            fmt::format("Position does not match any board size: {}", position)
+        );
+    }
+    Board board(size);
+    for (size_t index = 0; index < disks.size(); ++index) {
+        Disk disk;
+        switch (disks[index]) {
+            case 'B':
+                disk = Disk::black;
+                break;
+            case 'W':
+                disk = Disk::white;
+                break;
+            case '_':
+                disk = Disk::empty;
+                break;
+            default:
+                throw std::invalid_argument(
+                    fmt::format("Invalid square '{}' in position: {}", disks[index], position)
+                );
+        }
+        board.visit([&](auto& sized) { sized.set(index, disk); });
+    }
+    if (position[0] == 'W') {
+        board.pass();
+    }
+    return board;
+}
+
 /// Return true if board contains empty squares.
 bool Board::can_play() const
 {
-    return !empty_squares.empty();
+    return visit([](const auto& sized) { return any(sized.empty()); });
+}
+
+/// Returns the number of empty squares left on the board.
+size_t Board::empty_count() const
+{
+    return visit([](const auto& sized) { return count(sized.empty()); });
 }
 
 /// Update board for given disk placement.
 void Board::place_disk(const Move& chosen_move)
+{
+    static_cast<void>(make_move(chosen_move));
+}
+
+/// Update board for given disk placement and return the record needed to take it back.
+///
+/// Taking a move back with `unmake_move` only touches the changed squares,
+/// so search code can explore alternatives without copying the board.
+Board::Undo Board::make_move(const Move& chosen_move)
 {
     const auto start = chosen_move.square;
     const auto square = get_square(start);
@@ -47,43 +107,72 @@ void Board::place_disk(const Move& chosen_move)
             fmt::format("Trying to place disk to an occupied square: {}!", start)
         );
     }
-    set_square(start, chosen_move.disk);
-    empty_squares.erase(start);
-    for (const auto& affected_square : chosen_move.affected_squares()) {
-        set_square(affected_square, chosen_move.disk);
-    }
+    const size_t index = square_index(start);
+    return visit([&](auto& sized) {
+        const auto undo = sized.make_move(chosen_move.disk, index);
+        return Undo {widen(undo.flipped), undo.index, undo.disk, undo.hash, undo.side};
+    });
+}
+
+/// Take back a move made with `make_move`.
+/// Moves must be taken back in reverse order.
+void Board::unmake_move(const Undo& undo)
+{
+    visit([&](auto& sized) {
+        using Bits = typename std::remove_cvref_t<decltype(sized)>::Bits;
+        sized.unmake_move(
+            {narrow<Bits>(undo.flipped), undo.index, undo.disk, undo.hash, undo.side}
+        );
+    });
+}
+
+/// Skip a turn for the side to move.
+void Board::pass()
+{
+    visit([](auto& sized) { sized.pass(); });
+}
+
+/// Returns the disk colour whose turn it is.
+Disk Board::side_to_move() const
+{
+    return visit([](const auto& sized) { return sized.side_to_move(); });
+}
+
+/// Returns the Zobrist hash of the current position including the side to move.
+///
+/// Maintained incrementally on every disk placement,
+/// so positions can be cached and deduplicated without formatting the board.
+uint64_t Board::hash() const
+{
+    return visit([](const auto& sized) { return sized.hash(); });
 }
 
 /// Returns a list of possible moves for the given player.
 std::vector<Move> Board::possible_moves(Disk disk) const
 {
     std::vector<Move> moves;
-    const Disk opposing_disk = opponent(disk);
-    for (const Square& square : empty_squares) {
-        size_t value {0};
-        std::vector<Direction> directions;
-        for (const auto& step : STEP_DIRECTIONS) {
-            Square pos {square + step};
-            // Next square in this direction needs to be the opposing disk
-            if (get_square(pos) != opposing_disk) {
-                continue;
-            }
-            size_t num_steps {0};
-            // Keep stepping over opponents disks
-            while (get_square(pos) == opposing_disk) {
-                ++num_steps;
-                pos += step;
-            }
-            // Valid move only if a line of opposing disks ends with own disk
-            if (get_square(pos) == disk) {
-                directions.emplace_back(step, num_steps);
-                value += num_steps;
-            }
-        }
-        if (value > 0) {
-            moves.emplace_back(square, disk, value, directions);
+    visit([&](const auto& sized) {
+        using Geometry = typename std::remove_cvref_t<decltype(sized)>::Geometry;
+        const auto own = sized.disks(disk);
+        const auto opponent_disks = sized.disks(opponent(disk));
+        auto candidates = sized.legal_moves(disk);
+        moves.reserve(count(candidates));
+        while (any(candidates)) {
+            const size_t index = pop_lowest(candidates);
+            size_t value {0};
+            DirectionList directions;
+            for_each_direction([&](auto direction) {
+                constexpr size_t D = decltype(direction)::value;
+                const size_t flips
+                    = count(Geometry::template flips_in_direction<D>(own, opponent_disks, index));
+                if (flips > 0) {
+                    directions.emplace_back(STEP_DIRECTIONS[D], flips);
+                    value += flips;
+                }
+            });
+            moves.emplace_back(sized.index_square(index), disk, value, directions);
         }
-    }
+    });
     std::ranges::sort(moves);
     return moves;
 }
@@ -93,10 +182,10 @@ void Board::print_possible_moves(const std::vector<Move>& moves) const
 {
     print_yellow("  Possible moves ({}):\n", moves.size());
     // Convert board from Disk enums to strings
-    std::vector<std::string> formatted_board(board.size());
-    std::ranges::transform(board, formatted_board.begin(), [&](const Disk& disk) {
-        return board_char_with_color(disk);
-    });
+    std::vector<std::string> formatted_board(size * size);
+    for (size_t index = 0; index < formatted_board.size(); ++index) {
+        formatted_board[index] = board_char_with_color(disk_at(index));
+    }
     // Add possible moves to board
     for (const Move& possible_move : moves) {
         const auto index = square_index(possible_move.square);
@@ -143,14 +232,18 @@ Disk Board::result() const
 /// Get board status string for game log.
 std::string Board::log_entry() const
 {
-    return std::accumulate(
-        board.begin(),
-        board.end(),
-        std::string {},
-        [](const std::string& accumulator, const Disk& disk) {
-            return accumulator + board_char(disk);
-        }
-    );
+    std::string entry;
+    entry.reserve(size * size);
+    for (size_t index = 0; index < size * size; ++index) {
+        entry += board_char(disk_at(index));
+    }
+    return entry;
+}
+
+/// Returns the position string with the side to move, the inverse of `from_position`.
+std::string Board::position() const
+{
+    return board_char(side_to_move()) + ":" + log_entry();
 }
 
 /// Check that the given coordinates are valid (inside the board).
@@ -168,7 +261,13 @@ constexpr bool Board::check_square(const Square& square) const
 /// Returns the state of the board (empty, white, black) at the given square.
 std::optional<Disk> Board::get_square(const Square& square) const
 {
-    return check_square(square) ? std::optional {board[square_index(square)]} : std::nullopt;
+    return check_square(square) ? std::optional {disk_at(square_index(square))} : std::nullopt;
+}
+
+/// Returns the state of the board (empty, white, black) at the given board index.
+Disk Board::disk_at(const size_t index) const
+{
+    return visit([index](const auto& sized) { return sized.get(index); });
 }
 
 /// Map square to board index.
@@ -180,32 +279,25 @@ constexpr size_t Board::square_index(const Square& square) const
 /// Count and return the number of black and white disks.
 std::tuple<int, int> Board::player_scores() const
 {
-    int black = 0;
-    int white = 0;
-    for (const auto& disk : board) {
-        switch (disk) {
-            case Disk::black:
-                ++black;
-                break;
-            case Disk::white:
-                ++white;
-                break;
-            default:
-                break;
-        }
-    }
-    return {black, white};
+    return visit([](const auto& sized) {
+        return std::tuple {
+            static_cast<int>(sized.count(Disk::black)), static_cast<int>(sized.count(Disk::white))
+        };
+    });
 }
 
 /// Returns the total score.
 /// Positive value means more white disks and negative means more black disks.
 int Board::score() const
 {
-    // Enum class prevents implicit conversion from Disk to int,
-    // need to use lambda to cast Disk values to int.
-    return std::accumulate(board.begin(), board.end(), 0, [](const int sum, Disk disk) {
-        return sum + static_cast<int>(disk);
-    });
+    return visit([](const auto& sized) { return sized.score(); });
+}
+
+/// Heuristic pattern-based score of the position.
+/// Positive value favours the given disk colour.
+int Board::evaluate(const Disk disk) const
+{
+    return visit([disk](const auto& sized) { return othello::evaluate(sized, disk); });
 }
 
 /// Sets the given square to the given value.
@@ -214,34 +306,23 @@ void Board::set_square(const Square& square, const Disk disk)
     if (!check_square(square)) {
         throw std::invalid_argument(fmt::format("Invalid coordinates: {}", square));
     }
-    board[square_index(square)] = disk;
-}
-
-/// Initialize game board with starting disk positions.
-std::vector<Disk> Board::init_board(const size_t size)
-{
-    // Initialize game board with empty disks
-    std::vector<Disk> board(size * size, Disk::empty);
-    // Set starting positions
-    const size_t row = size % 2 == 0 ? (size - 1) / 2 : (size - 1) / 2 - 1;
-    const size_t col = size / 2;
-    board[row * size + row] = Disk::white;
-    board[row * size + col] = Disk::black;
-    board[col * size + row] = Disk::black;
-    board[col * size + col] = Disk::white;
-    return board;
+    visit([&](auto& sized) { sized.set(square_index(square), disk); });
 }
 
-/// Initialize empty squares for the board.
-std::set<Square> Board::init_empty_squares(const size_t size, const std::vector<Disk>& board)
+/// Initialize game board with starting disk positions for the given board size.
+BoardVariant Board::init_board(const size_t size)
 {
-    std::set<Square> empty_squares;
-    for (size_t index = 0; index < board.size(); ++index) {
-        if (board[index] == Disk::empty) {
-            empty_squares.emplace(static_cast<int>(index % size), static_cast<int>(index / size));
-        }
+    BoardVariant board;
+    const bool supported = [&]<size_t... Offsets>(std::index_sequence<Offsets...>) {
+        return ((size == MIN_BOARD_SIZE + Offsets
+                     ? (board.emplace<SizedBoard<MIN_BOARD_SIZE + Offsets>>(), true)
+                     : false)
+                || ...);
+    }(std::make_index_sequence<std::variant_size_v<BoardVariant>> {});
+    if (!supported) {
+        throw std::invalid_argument(fmt::format("Unsupported board size: {}", size));
     }
-    return empty_squares;
+    return board;
 }
 
 /// Format game board to string
@@ -254,7 +335,7 @@ std::ostream& operator<<(std::ostream& out, const Board& board)
         out << "\n" << fmt::format(fmt::emphasis::bold, "{}", y);
         // Row values
         for (const auto x : board.indices) {
-            out << " " << board_char_with_color(board.board[y * board.size + x]);
+            out << " " << board_char_with_color(board.disk_at(y * board.size + x));
         }
     }
     return out;
@@ -7,67 +7,92 @@
 
 #pragma once
 #include "models.hpp"
+#include "settings.hpp"
+#include "sized_board.hpp"
 
-#include <array>
 #include <optional>
-#include <set>
+#include <string_view>
 #include <tuple>
+#include <utility>  // std::forward, std::index_sequence
+#include <variant>
 #include <vector>
 
 namespace othello
 {
-constexpr int UP = 1;
-constexpr int DOWN = -1;
-constexpr int LEFT = -1;
-constexpr int RIGHT = 1;
-constexpr int STILL = 0;
-
-/// All possible step directions for a square on the board.
-static constexpr std::array<Step, 8> STEP_DIRECTIONS {{
-    {DOWN, LEFT},
-    {DOWN, RIGHT},
-    {DOWN, STILL},
-    {STILL, LEFT},
-    {STILL, RIGHT},
-    {UP, LEFT},
-    {UP, RIGHT},
-    {UP, STILL},
-}};
+namespace detail
+{
+template<size_t... Offsets>
+auto sized_board_variant(std::index_sequence<Offsets...>)
+    -> std::variant<SizedBoard<MIN_BOARD_SIZE + Offsets>...>;
+}  // namespace detail
+
+/// Size-specialised board for every supported board size.
+using BoardVariant = decltype(detail::sized_board_variant(
+    std::make_index_sequence<MAX_BOARD_SIZE - MIN_BOARD_SIZE + 1> {}
+));
 
 /// Handles game board state and logic.
 class Board
 {
 public:
+    /// Move record wide enough for every board size.
+    using Undo = MoveUndo<Bitboard128>;
+
     explicit Board(size_t size);
 
+    [[nodiscard]] static Board from_position(std::string_view position);
+
     [[nodiscard]] bool can_play() const;
+    [[nodiscard]] size_t empty_count() const;
     void place_disk(const Move& chosen_move);
+    Undo make_move(const Move& chosen_move);
+    void unmake_move(const Undo& undo);
+    void pass();
+    [[nodiscard]] Disk side_to_move() const;
+    [[nodiscard]] uint64_t hash() const;
     [[nodiscard]] std::vector<Move> possible_moves(Disk disk) const;
     void print_possible_moves(const std::vector<Move>& moves) const;
     void print_score() const;
     [[nodiscard]] Disk result() const;
+    [[nodiscard]] int evaluate(Disk disk) const;
     [[nodiscard]] std::string log_entry() const;
+    [[nodiscard]] std::string position() const;
+
+    /// Call the given function with the size-specialised board.
+    ///
+    /// The board size is resolved once here,
+    /// so everything inside the function runs code compiled for that exact size.
+    template<typename F>
+    decltype(auto) visit(F&& function) const
+    {
+        return std::visit(std::forward<F>(function), board);
+    }
+
+    /// Call the given function with the mutable size-specialised board.
+    template<typename F>
+    decltype(auto) visit(F&& function)
+    {
+        return std::visit(std::forward<F>(function), board);
+    }
 
 private:
     [[nodiscard]] constexpr bool check_coordinates(int x, int y) const;
     [[nodiscard]] constexpr bool check_square(const Square& square) const;
     [[nodiscard]] std::optional<Disk> get_square(const Square& square) const;
+    [[nodiscard]] Disk disk_at(size_t index) const;
     [[nodiscard]] constexpr size_t square_index(const Square& square) const;
     [[nodiscard]] std::tuple<int, int> player_scores() const;
     [[nodiscard]] int score() const;
     void set_square(const Square& square, Disk disk);
-    [[nodiscard]] static std::vector<Disk> init_board(size_t size);
-    [[nodiscard]] static std::set<Square> init_empty_squares(
-        size_t size,
-        const std::vector<Disk>& board
-    );
+    [[nodiscard]] static BoardVariant init_board(size_t size);
 
     friend std::ostream& operator<<(std::ostream& out, const Board& board);
 
     friend class BoardTest;
 
-    std::vector<Disk> board;
-    std::set<Square> empty_squares;
+    // Board state specialised for the chosen size.
+    // Boards up to 8x8 fit into a single 64-bit word per colour, larger boards use two words.
+    BoardVariant board;
     std::vector<size_t> indices;
     size_t size;
 };
@@ -0,0 +1,391 @@
+//==========================================================
+// Book builder source
+// Builds an opening book by expanding the opening tree
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "book_builder.hpp"
+
+#include "evaluation.hpp"
+#include "search.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>  // std::ranges::find_if, std::ranges::max, std::ranges::sort
+#include <atomic>
+#include <cstdio>  // std::fflush
+#include <exception>
+#include <functional>  // std::ranges::greater
+#include <sstream>
+#include <stdexcept>
+#include <thread>       // std::jthread
+#include <type_traits>  // std::remove_cvref_t
+#include <utility>      // std::move
+
+namespace othello
+{
+namespace
+{
+/// First line of a checkpoint file, followed by the board size and the search depth.
+constexpr std::string_view CHECKPOINT_HEADER = "othello-book";
+
+/// Number of moves played from the start.
+int ply_of(const Board& board)
+{
+    const size_t squares = board.visit([](const auto& sized) {
+        return std::remove_cvref_t<decltype(sized)>::SQUARES;
+    });
+    return static_cast<int>(squares - 4 - board.empty_count());
+}
+}  // namespace
+
+/// Play the move with the given board index for the side to move,
+/// and pass for the opponent if it has no moves.
+/// Returns false if the game is over after the move.
+bool play_book_move(Board& board, const size_t index)
+{
+    const Disk disk = board.side_to_move();
+    const auto moves = board.possible_moves(disk);
+    const auto move = std::ranges::find_if(moves, [&](const Move& candidate) {
+        return board.visit([&](const auto& sized) {
+            return std::remove_cvref_t<decltype(sized)>::square_index(candidate.square) == index;
+        });
+    });
+    if (move == moves.end()) {
+        throw std::runtime_error(
+            fmt::format("Invalid book move {} in {}", index, board.position())
+        );
+    }
+    board.place_disk(*move);
+    if (!board.possible_moves(opponent(disk)).empty()) {
+        return true;
+    }
+    if (!board.possible_moves(disk).empty()) {
+        board.pass();
+        return true;
+    }
+    return false;
+}
+
+BookBuilder::BookBuilder(BookSettings settings) : settings(std::move(settings))
+{
+    if (this->settings.board_size < MIN_BOARD_SIZE || this->settings.board_size > MAX_BOARD_SIZE) {
+        throw std::invalid_argument(
+            fmt::format("Unsupported board size: {}", this->settings.board_size)
+        );
+    }
+    if (this->settings.depth < 1 || this->settings.depth > MAX_SEARCH_DEPTH) {
+        throw std::invalid_argument(
+            fmt::format("Unsupported search depth: {}", this->settings.depth)
+        );
+    }
+    if (this->settings.plies < 0 || this->settings.drop_out < 0) {
+        throw std::invalid_argument("Book plies and drop-out can't be negative");
+    }
+    if (this->settings.threads == 0) {
+        throw std::invalid_argument("Book builder needs at least one thread");
+    }
+    if (this->settings.output.empty()) {
+        throw std::invalid_argument("Book builder needs an output file");
+    }
+    if (this->settings.checkpoint.empty()) {
+        this->settings.checkpoint = this->settings.output;
+        this->settings.checkpoint += ".checkpoint";
+    }
+}
+
+/// Expand the opening tree ply by ply, continuing from the checkpoint if there is one,
+/// and write the book file.
+void BookBuilder::build()
+{
+    load_checkpoint();
+    for (int ply = 0; ply < settings.plies; ++ply) {
+        const auto positions = next_positions(ply);
+        if (settings.verbose) {
+            fmt::print("Ply {:>2}: {} positions to expand\n", ply, positions.size());
+        }
+        expand(positions);
+    }
+    const auto book = records();
+    OpeningBook::write(settings.output, settings.board_size, book);
+    if (settings.verbose) {
+        fmt::print("Wrote {} positions to {}\n", book.size(), settings.output.string());
+    }
+}
+
+/// Book records with the best move of each expanded position.
+std::vector<BookRecord> BookBuilder::records() const
+{
+    const auto scores = backed_up_scores();
+    std::vector<BookRecord> book;
+    book.reserve(nodes.size());
+    for (const auto& [key, node] : nodes) {
+        const Board board = Board::from_position(node.position);
+        const auto canonical = canonical_position(board, board.side_to_move());
+        size_t best_move = node.moves.front().index;
+        int best_score = -INFINITE_SCORE;
+        for (const auto& move : node.moves) {
+            const int score = backed_up_score(board, move, scores);
+            if (score > best_score) {
+                best_score = score;
+                best_move = move.index;
+            }
+        }
+        const Square square = board.visit([&](const auto& sized) {
+            return std::remove_cvref_t<decltype(sized)>::index_square(best_move);
+        });
+        book.push_back({
+            canonical.key,
+            static_cast<int16_t>(best_score),
+            static_cast<uint8_t>(to_canonical_move(board, square, canonical.symmetry)),
+            static_cast<uint8_t>(settings.depth),
+        });
+    }
+    return book;
+}
+
+/// Number of expanded positions.
+size_t BookBuilder::size() const
+{
+    return nodes.size();
+}
+
+/// Positions to expand at the given ply.
+/// These are the children of the expanded positions one ply earlier
+/// that are within the drop-out limit and not expanded yet.
+std::vector<BookBuilder::PendingNode> BookBuilder::next_positions(const int ply) const
+{
+    std::unordered_map<uint64_t, PendingNode> pending;
+    if (ply == 0) {
+        Board board(settings.board_size);
+        const uint64_t key = canonical_position(board, board.side_to_move()).key;
+        if (!nodes.contains(key)) {
+            pending.emplace(key, PendingNode {std::move(board), key, 0});
+        }
+    }
+    for (const auto& [key, node] : nodes) {
+        if (node.ply != ply - 1) {
+            continue;
+        }
+        const Board board = Board::from_position(node.position);
+        const int best = std::ranges::max(node.moves, {}, &ScoredMove::score).score;
+        for (const auto& move : node.moves) {
+            const int drop = node.drop + best - move.score;
+            if (drop > settings.drop_out) {
+                continue;
+            }
+            Board child = board;
+            if (!play_book_move(child, move.index)) {
+                continue;
+            }
+            const uint64_t child_key = canonical_position(child, child.side_to_move()).key;
+            if (nodes.contains(child_key)) {
+                continue;
+            }
+            // Keep the cheapest way to reach a transposition
+            const auto [existing, inserted]
+                = pending.try_emplace(child_key, PendingNode {child, child_key, drop});
+            if (!inserted && drop < existing->second.drop) {
+                existing->second.drop = drop;
+            }
+        }
+    }
+    std::vector<PendingNode> positions;
+    positions.reserve(pending.size());
+    for (auto& [key, position] : pending) {
+        positions.push_back(std::move(position));
+    }
+    // Fixed order so that builds with the same settings run the same searches
+    std::ranges::sort(positions, {}, &PendingNode::key);
+    return positions;
+}
+
+/// Score the moves of the given positions in parallel and add them to the book.
+///
+/// Each worker thread takes the next position from the shared list,
+/// and searches with its own transposition table.
+/// Finished positions are saved to the checkpoint right away.
+void BookBuilder::expand(const std::vector<PendingNode>& positions)
+{
+    std::atomic<size_t> next {0};
+    size_t finished = 0;
+    std::exception_ptr error;
+    {
+        std::vector<std::jthread> workers;
+        const size_t threads = std::min(settings.threads, positions.size());
+        workers.reserve(threads);
+        for (size_t thread = 0; thread < threads; ++thread) {
+            workers.emplace_back([&] {
+                try {
+                    TranspositionTable table;
+                    for (size_t index = next++; index < positions.size(); index = next++) {
+                        const auto& position = positions[index];
+                        BookNode node {
+                            position.board.position(),
+                            position.drop,
+                            ply_of(position.board),
+                            score_moves(position.board, table),
+                        };
+                        const std::scoped_lock lock(mutex);
+                        save_node(node);
+                        nodes.emplace(position.key, std::move(node));
+                        ++finished;
+                        if (settings.verbose) {
+                            fmt::print("\r  {}/{}", finished, positions.size());
+                            std::fflush(stdout);
+                        }
+                    }
+                } catch (...) {
+                    const std::scoped_lock lock(mutex);
+                    error = std::current_exception();
+                    next = positions.size();
+                }
+            });
+        }
+    }
+    if (settings.verbose && !positions.empty()) {
+        fmt::print("\n");
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/// Search score of each legal move from the point of view of the side to move.
+std::vector<BookBuilder::ScoredMove>
+BookBuilder::score_moves(const Board& board, TranspositionTable& table) const
+{
+    const Disk disk = board.side_to_move();
+    const SearchLimits limits {settings.depth, std::nullopt, 1};
+    std::vector<ScoredMove> moves;
+    for (const auto& move : board.possible_moves(disk)) {
+        Board child = board;
+        child.place_disk(move);
+        const auto result = search(child, opponent(disk), limits, table);
+        const size_t index = board.visit([&](const auto& sized) {
+            return std::remove_cvref_t<decltype(sized)>::square_index(move.square);
+        });
+        moves.push_back({index, -result.score});
+    }
+    return moves;
+}
+
+/// Negamax scores of the expanded positions backed up from the deepest plies,
+/// so each position is scored from the best lines found in the whole tree.
+std::unordered_map<uint64_t, int> BookBuilder::backed_up_scores() const
+{
+    std::vector<std::pair<uint64_t, const BookNode*>> order;
+    order.reserve(nodes.size());
+    for (const auto& [key, node] : nodes) {
+        order.emplace_back(key, &node);
+    }
+    std::ranges::sort(order, std::ranges::greater {}, [](const auto& entry) {
+        return entry.second->ply;
+    });
+    std::unordered_map<uint64_t, int> scores;
+    scores.reserve(nodes.size());
+    for (const auto& [key, node] : order) {
+        const Board board = Board::from_position(node->position);
+        int best = -INFINITE_SCORE;
+        for (const auto& move : node->moves) {
+            best = std::max(best, backed_up_score(board, move, scores));
+        }
+        scores[key] = best;
+    }
+    return scores;
+}
+
+/// Score of a move from the backed up score of the position it leads to,
+/// or from its own search if that position was not expanded.
+int BookBuilder::backed_up_score(
+    const Board& board,
+    const ScoredMove& move,
+    const std::unordered_map<uint64_t, int>& scores
+)
+{
+    Board child = board;
+    if (!play_book_move(child, move.index)) {
+        return move.score;
+    }
+    const auto found = scores.find(canonical_position(child, child.side_to_move()).key);
+    if (found == scores.end()) {
+        return move.score;
+    }
+    return child.side_to_move() == board.side_to_move() ? found->second : -found->second;
+}
+
+/// Read the positions expanded by an earlier build and open the checkpoint for appending.
+///
+/// Each line is one position: the position string, the drop, the number of moves,
+/// and the board index and score of each move.
+/// A last line without a newline was cut short by an interrupted build and is dropped.
+void BookBuilder::load_checkpoint()
+{
+    const auto& path = settings.checkpoint;
+    const std::string header
+        = fmt::format("{} {} {}", CHECKPOINT_HEADER, settings.board_size, settings.depth);
+    if (std::filesystem::exists(path)) {
+        std::ifstream file(path);
+        std::string line;
+        if (!std::getline(file, line) || line != header) {
+            throw std::runtime_error(
+                fmt::format(
+                    "Checkpoint {} does not match board size {} and depth {}",
+                    path.string(),
+                    settings.board_size,
+                    settings.depth
+                )
+            );
+        }
+        std::streamoff complete = file.tellg();
+        while (std::getline(file, line) && !file.eof()) {
+            std::istringstream fields(line);
+            BookNode node;
+            size_t count = 0;
+            if (!(fields >> node.position >> node.drop >> count) || count == 0) {
+                break;
+            }
+            node.moves.resize(count);
+            for (auto& move : node.moves) {
+                fields >> move.index >> move.score;
+            }
+            if (!fields) {
+                break;
+            }
+            const Board board = Board::from_position(node.position);
+            node.ply = ply_of(board);
+            nodes.emplace(canonical_position(board, board.side_to_move()).key, std::move(node));
+            complete = file.tellg();
+        }
+        file.close();
+        std::filesystem::resize_file(path, static_cast<uintmax_t>(complete));
+        if (settings.verbose) {
+            fmt::print("Resuming from {} with {} positions\n", path.string(), nodes.size());
+        }
+        checkpoint.open(path, std::ios::app);
+    } else {
+        checkpoint.open(path);
+        checkpoint << header << '\n';
+    }
+    if (!checkpoint) {
+        throw std::runtime_error(fmt::format("Failed to open checkpoint: {}", path.string()));
+    }
+}
+
+/// Append an expanded position to the checkpoint.
+void BookBuilder::save_node(const BookNode& node)
+{
+    checkpoint << node.position << ' ' << node.drop << ' ' << node.moves.size();
+    for (const auto& move : node.moves) {
+        checkpoint << ' ' << move.index << ' ' << move.score;
+    }
+    checkpoint << '\n' << std::flush;
+    if (!checkpoint) {
+        throw std::runtime_error(
+            fmt::format("Failed to write checkpoint: {}", settings.checkpoint.string())
+        );
+    }
+}
+
+}  // namespace othello
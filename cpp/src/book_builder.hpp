@@ -0,0 +1,118 @@
+//==========================================================
+// Book builder header
+// Builds an opening book by expanding the opening tree
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+#include "opening_book.hpp"
+#include "transposition_table.hpp"
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace othello
+{
+/// Default search depth for scoring book positions.
+constexpr int DEFAULT_BOOK_DEPTH = 10;
+/// Default number of moves from the start covered by the book.
+constexpr int DEFAULT_BOOK_PLIES = 12;
+/// Default score a book line may give away compared to the best moves.
+constexpr int DEFAULT_BOOK_DROP_OUT = 64;
+
+/// Settings for building an opening book.
+struct BookSettings {
+    size_t board_size {DEFAULT_BOARD_SIZE};
+    /// Search depth for scoring each move
+    int depth {DEFAULT_BOOK_DEPTH};
+    /// Number of moves from the start to expand
+    int plies {DEFAULT_BOOK_PLIES};
+    /// Total score a line can lose against the best moves before it is no longer expanded
+    int drop_out {DEFAULT_BOOK_DROP_OUT};
+    /// Number of search threads
+    size_t threads {1};
+    /// Book file to write
+    std::filesystem::path output;
+    /// Progress file the build is resumed from
+    std::filesystem::path checkpoint;
+    /// Print progress
+    bool verbose {true};
+};
+
+/// Builds an opening book with drop-out expansion.
+///
+/// The opening tree is expanded one ply at a time from the start position.
+/// Every move of an expanded position is scored with a search,
+/// and a child position is expanded in turn if the moves leading to it
+/// together lose at most `drop_out` against the best move of each position on the way.
+/// This covers the main lines deeply and keeps bad moves out of the book,
+/// while still answering reasonable deviations from the best line.
+///
+/// Positions are scored in parallel. Each finished position is appended to the checkpoint file,
+/// so an interrupted build continues from where it stopped when started again.
+/// The checkpoint is kept after the build, and running again with more plies
+/// or a larger drop-out extends the existing tree.
+class BookBuilder
+{
+public:
+    explicit BookBuilder(BookSettings settings);
+
+    void build();
+    [[nodiscard]] std::vector<BookRecord> records() const;
+    [[nodiscard]] size_t size() const;
+
+private:
+    /// Score of one move from the point of view of the side to move.
+    struct ScoredMove {
+        size_t index {0};
+        int score {0};
+    };
+
+    /// Expanded book position.
+    struct BookNode {
+        /// Position string with the side to move
+        std::string position;
+        /// Score lost against the best moves on the way to this position
+        int drop {0};
+        /// Number of moves played from the start
+        int ply {0};
+        std::vector<ScoredMove> moves;
+    };
+
+    /// Position waiting to be expanded.
+    struct PendingNode {
+        Board board;
+        uint64_t key {0};
+        int drop {0};
+    };
+
+    [[nodiscard]] std::vector<PendingNode> next_positions(int ply) const;
+    void expand(const std::vector<PendingNode>& positions);
+    [[nodiscard]] std::vector<ScoredMove>
+    score_moves(const Board& board, TranspositionTable& table) const;
+    [[nodiscard]] std::unordered_map<uint64_t, int> backed_up_scores() const;
+    [[nodiscard]] static int backed_up_score(
+        const Board& board,
+        const ScoredMove& move,
+        const std::unordered_map<uint64_t, int>& scores
+    );
+    void load_checkpoint();
+    void save_node(const BookNode& node);
+
+    BookSettings settings;
+    std::unordered_map<uint64_t, BookNode> nodes;
+    std::ofstream checkpoint;
+    std::mutex mutex;
+};
+
+[[nodiscard]] bool play_book_move(Board& board, size_t index);
+
+}  // namespace othello
@@ -0,0 +1,103 @@
+//==========================================================
+// Book builder main
+// Build an opening book for the computer player
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "book_builder.hpp"
+#include "colorprint.hpp"
+#include "cxxopts.hpp"
+#include "search.hpp"
+#include "version.hpp"
+
+#include <algorithm>  // std::max
+#include <string>
+#include <thread>  // std::thread::hardware_concurrency
+
+inline cxxopts::Options cli_arguments()
+{
+    cxxopts::Options options("othello_book", "Build an opening book for Othello C++");
+    options.custom_help("[OPTIONS]");
+    options.positional_help(
+        fmt::format(
+            "[SIZE]\n\nArguments:\n  [SIZE]            Optional board size ({}..{})",
+            othello::MIN_BOARD_SIZE,
+            othello::MAX_BOARD_SIZE
+        )
+    );
+
+    options.add_options("Positional")(
+        "size",
+        fmt::format(
+            "Optional board size ({}..{})", othello::MIN_BOARD_SIZE, othello::MAX_BOARD_SIZE
+        ),
+        cxxopts::value<size_t>()->default_value(std::to_string(othello::DEFAULT_BOARD_SIZE))
+    );
+
+    const auto threads = std::to_string(std::max(std::thread::hardware_concurrency(), 1U));
+
+    // clang-format off
+    options.add_options("Optional")
+        ("o,output", "Book file to write", cxxopts::value<std::string>()->default_value("othello.book"))
+        ("checkpoint", "Progress file to resume from, defaults to the book file with .checkpoint added", cxxopts::value<std::string>())
+        ("depth", "Search depth for scoring moves", cxxopts::value<int>()->default_value(std::to_string(othello::DEFAULT_BOOK_DEPTH)))
+        ("plies", "Number of moves from the start to cover", cxxopts::value<int>()->default_value(std::to_string(othello::DEFAULT_BOOK_PLIES)))
+        ("drop", "Score a line can lose against the best moves and still be expanded", cxxopts::value<int>()->default_value(std::to_string(othello::DEFAULT_BOOK_DROP_OUT)))
+        ("threads", "Number of search threads", cxxopts::value<size_t>()->default_value(threads))
+        ("h,help", "Print help and exit", cxxopts::value<bool>())
+        ("v,version", "Print version and exit", cxxopts::value<bool>());
+    // clang-format on
+
+    options.parse_positional({"size"});
+
+    return options;
+}
+
+int main(const int argc, const char* argv[])
+{
+    try {
+        auto options = cli_arguments();
+        const auto parsed_args = options.parse(argc, argv);
+
+        if (parsed_args["version"].as<bool>()) {
+            fmt::print("{}\n", version::version_info());
+            return 0;
+        }
+        if (parsed_args["help"].as<bool>()) {
+            fmt::print("{}", options.help({"Optional"}));
+            return 0;
+        }
+
+        othello::BookSettings settings;
+        settings.board_size = parsed_args["size"].as<size_t>();
+        settings.output = parsed_args["output"].as<std::string>();
+        if (parsed_args.count("checkpoint") > 0) {
+            settings.checkpoint = parsed_args["checkpoint"].as<std::string>();
+        }
+        settings.depth = parsed_args["depth"].as<int>();
+        settings.plies = parsed_args["plies"].as<int>();
+        settings.drop_out = parsed_args["drop"].as<int>();
+        settings.threads = parsed_args["threads"].as<size_t>();
+
+        print_green_bold("OTHELLO BOOK - C++\n");
+        fmt::println(
+            "Board size {}, depth {}, plies {}, drop-out {}, {} threads",
+            settings.board_size,
+            settings.depth,
+            settings.plies,
+            settings.drop_out,
+            settings.threads
+        );
+
+        othello::BookBuilder(settings).build();
+    } catch (const cxxopts::exceptions::exception& e) {
+        print_error(e.what());
+        return 1;
+    } catch (const std::exception& e) {
+        print_error(e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+//==========================================================
+// Computer player source
+// Picks moves for the computer without any input or output
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "computer.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>  // std::ranges::find_if
+#include <stdexcept>
+#include <utility>  // std::move
+
+namespace othello
+{
+Computer::Computer(const Disk disk, SearchSettings settings, const bool test_mode) :
+    side(disk),
+    settings(std::move(settings)),
+    test_mode(test_mode)
+{
+    if (!this->settings.book.empty()) {
+        book = std::make_shared<const OpeningBook>(this->settings.book);
+    }
+    if (!this->settings.tablebase.empty()) {
+        tablebase = std::make_shared<const Tablebase>(this->settings.tablebase);
+    }
+}
+
+/// Pick a move from the given legal moves.
+ComputerMove Computer::choose_move(const Board& board, const std::vector<Move>& moves)
+{
+    const size_t endgame = this->settings.endgame;
+    if (this->test_mode && this->settings.depth == 0) {
+        return {moves[0], {}};
+    }
+    if (auto move = tablebase_move(board, moves)) {
+        return *move;
+    }
+    if (auto move = book_move(board, moves)) {
+        return *move;
+    }
+    if (endgame > 0 && board.empty_count() <= endgame) {
+        return endgame_move(board, moves);
+    }
+    if (this->settings.engine == Engine::mcts) {
+        return monte_carlo_move(board, moves);
+    }
+    if (this->settings.depth > 0) {
+        const SearchLimits limits {this->settings.depth, std::nullopt, this->settings.threads};
+        return search_move(board, moves, limits);
+    }
+    const SearchLimits limits {MAX_SEARCH_DEPTH, move_time_limit(board), this->settings.threads};
+    return search_move(board, moves, limits);
+}
+
+/// Reset for a new game.
+void Computer::reset()
+{
+    this->time_used = std::chrono::milliseconds {0};
+}
+
+/// Seed the random generator used for move times and Monte Carlo playouts.
+void Computer::set_seed(const uint64_t seed)
+{
+    this->random.seed(static_cast<std::mt19937::result_type>(seed));
+}
+
+/// The disk colour this computer plays.
+Disk Computer::disk() const
+{
+    return side;
+}
+
+/// Time spent searching during the current game.
+std::chrono::milliseconds Computer::thinking_time() const
+{
+    return time_used;
+}
+
+/// Look up the perfect-play move in the tablebase.
+/// Returns nothing without a tablebase, or when the position is not in it.
+std::optional<ComputerMove> Computer::tablebase_move(
+    const Board& board,
+    const std::vector<Move>& moves
+) const
+{
+    if (!tablebase) {
+        return std::nullopt;
+    }
+    const auto found = tablebase->lookup(board, side);
+    if (!found) {
+        return std::nullopt;
+    }
+    return ComputerMove {find_move(moves, found->square, "Tablebase"), *found};
+}
+
+/// Look up the position in the opening book.
+/// Returns nothing without a book, or when the position is not in it.
+std::optional<ComputerMove> Computer::book_move(
+    const Board& board,
+    const std::vector<Move>& moves
+) const
+{
+    if (!book) {
+        return std::nullopt;
+    }
+    const auto found = book->lookup(board, side);
+    if (!found) {
+        return std::nullopt;
+    }
+    return ComputerMove {find_move(moves, found->square, "Opening book"), *found};
+}
+
+/// Search the game tree for the best move.
+ComputerMove Computer::search_move(
+    const Board& board,
+    const std::vector<Move>& moves,
+    const SearchLimits& limits
+)
+{
+    if (!table) {
+        table = std::make_shared<TranspositionTable>();
+    }
+    const auto result = search(board, side, limits, *table);
+    time_used += result.elapsed;
+    return {find_move(moves, result.best_move, "Search"), result};
+}
+
+/// Pick the best move with Monte Carlo tree search.
+ComputerMove Computer::monte_carlo_move(const Board& board, const std::vector<Move>& moves)
+{
+    MctsLimits limits;
+    limits.time = move_time_limit(board);
+    limits.threads = this->settings.threads;
+    limits.exploration = this->settings.exploration;
+    limits.seed = std::uniform_int_distribution<uint64_t> {}(this->random);
+    const auto result = monte_carlo_search(board, side, limits);
+    time_used += result.elapsed;
+    return {find_move(moves, result.best_move, "Monte Carlo search"), result};
+}
+
+/// Solve the rest of the game exactly and pick the best move.
+///
+/// When playing by time the solve gets the time of a normal move.
+/// If it does not finish in time, the move comes from a search in the time that is left.
+ComputerMove Computer::endgame_move(const Board& board, const std::vector<Move>& moves)
+{
+    if (!endgame_table) {
+        endgame_table = std::make_shared<TranspositionTable>();
+    }
+    std::optional<std::chrono::milliseconds> time;
+    if (this->settings.depth == 0) {
+        time = move_time_limit(board);
+    }
+    const auto result = solve_endgame(board, side, *endgame_table, time);
+    time_used += result.elapsed;
+    if (!result.complete) {
+        const auto remaining = std::max(*time - result.elapsed, std::chrono::milliseconds {0});
+        const SearchLimits limits {MAX_SEARCH_DEPTH, remaining, this->settings.threads};
+        return search_move(board, moves, limits);
+    }
+    return {find_move(moves, result.best_move, "Endgame solver"), result};
+}
+
+/// Time budget for the next computer move.
+///
+/// Uses the configured move time, or a random time of 1 to 2 seconds
+/// so the computer still takes a moment before playing.
+/// With a game clock, the remaining game time is split evenly over the remaining own moves.
+std::chrono::milliseconds Computer::move_time_limit(const Board& board)
+{
+    std::chrono::milliseconds limit {this->settings.move_time};
+    if (limit.count() == 0) {
+        std::uniform_int_distribution rand_time(1000, 2000);
+        limit = std::chrono::milliseconds(rand_time(this->random));
+    }
+    if (this->settings.game_time > 0) {
+        const std::chrono::milliseconds game_time = std::chrono::seconds(this->settings.game_time);
+        const auto own_moves_left = std::max<int64_t>((board.empty_count() + 1) / 2, 1);
+        // At least one millisecond per move, the first depth is searched regardless
+        const auto remaining
+            = std::max(game_time - time_used, std::chrono::milliseconds {own_moves_left});
+        limit = std::min(limit, remaining / own_moves_left);
+    }
+    return limit;
+}
+
+/// Returns the legal move for the square picked by a move source.
+Move Computer::find_move(
+    const std::vector<Move>& moves,
+    const std::optional<Square>& square,
+    const std::string_view source
+) const
+{
+    const auto found
+        = std::ranges::find_if(moves, [&](const Move& move) { return move.square == square; });
+    if (found == moves.end()) {
+        throw std::runtime_error(
+            fmt::format("{} returned an invalid move for {}", source, disk_string(side))
+        );
+    }
+    return *found;
+}
+
+}  // namespace othello
@@ -0,0 +1,95 @@
+//==========================================================
+// Computer player header
+// Picks moves for the computer without any input or output
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+#include "endgame.hpp"
+#include "mcts.hpp"
+#include "opening_book.hpp"
+#include "search.hpp"
+#include "settings.hpp"
+#include "tablebase.hpp"
+#include "transposition_table.hpp"
+
+#include <chrono>
+#include <cstdint>  // uint64_t
+#include <memory>   // std::shared_ptr
+#include <optional>
+#include <random>
+#include <variant>
+#include <vector>
+
+namespace othello
+{
+/// How the computer found its move.
+/// Empty for the deterministic first move of test mode.
+using MoveDetails
+    = std::variant<std::monostate, TablebaseMove, BookMove, SolveResult, MctsResult, SearchResult>;
+
+/// Move picked by the computer with the details of how it was found.
+struct ComputerMove {
+    Move move;
+    MoveDetails details;
+};
+
+/// Computer player move selection.
+///
+/// Goes through the tablebase, the opening book, the endgame solver
+/// and the configured search engine in that order.
+/// Never prints or reads anything, so it can be embedded and run in batches.
+class Computer
+{
+public:
+    Computer(Disk disk, SearchSettings settings, bool test_mode);
+
+    [[nodiscard]] ComputerMove choose_move(const Board& board, const std::vector<Move>& moves);
+    void reset();
+    void set_seed(uint64_t seed);
+    [[nodiscard]] Disk disk() const;
+    [[nodiscard]] std::chrono::milliseconds thinking_time() const;
+
+private:
+    [[nodiscard]] std::optional<ComputerMove> tablebase_move(
+        const Board& board,
+        const std::vector<Move>& moves
+    ) const;
+    [[nodiscard]] std::optional<ComputerMove> book_move(
+        const Board& board,
+        const std::vector<Move>& moves
+    ) const;
+    [[nodiscard]] ComputerMove search_move(
+        const Board& board,
+        const std::vector<Move>& moves,
+        const SearchLimits& limits
+    );
+    [[nodiscard]] ComputerMove monte_carlo_move(
+        const Board& board,
+        const std::vector<Move>& moves
+    );
+    [[nodiscard]] ComputerMove endgame_move(const Board& board, const std::vector<Move>& moves);
+    [[nodiscard]] std::chrono::milliseconds move_time_limit(const Board& board);
+    [[nodiscard]] Move find_move(
+        const std::vector<Move>& moves,
+        const std::optional<Square>& square,
+        std::string_view source
+    ) const;
+
+    Disk side;
+    SearchSettings settings;
+    bool test_mode;
+    // Time spent searching during the current game
+    std::chrono::milliseconds time_used {0};
+
+    std::mt19937 random {std::mt19937 {std::random_device {}()}};
+    // Created on first search and kept between moves
+    std::shared_ptr<TranspositionTable> table;
+    std::shared_ptr<TranspositionTable> endgame_table;
+    std::shared_ptr<const OpeningBook> book;
+    std::shared_ptr<const Tablebase> tablebase;
+};
+
+}  // namespace othello
@@ -0,0 +1,498 @@
+//==========================================================
+// Endgame source
+// Exact solver for the last moves of the game
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "endgame.hpp"
+
+#include "features.hpp"
+
+#include <array>
+#include <optional>
+#include <type_traits>  // std::is_same_v, std::remove_cvref_t
+
+namespace othello
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// Scores are disk differences so this is out of reach for every board size.
+constexpr int SOLVE_INFINITY = 1000;
+/// Positions with at least this many empty squares are cached in the table.
+constexpr size_t TABLE_MIN_EMPTIES = 7;
+/// Positions with at least this many empty squares order moves by opponent mobility.
+constexpr size_t FASTEST_FIRST_MIN_EMPTIES = 7;
+/// Positions with at least this many empty squares try a cutoff from the opponent's stable disks.
+constexpr size_t STABILITY_MIN_EMPTIES = 7;
+/// How many positions with more than four empty squares to solve between checks of the clock.
+constexpr uint64_t CLOCK_CHECK_INTERVAL = 1024;
+
+/// MurmurHash3 finalizer.
+constexpr uint64_t mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCD;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53;
+    value ^= value >> 33;
+    return value;
+}
+
+/// Exact minimax solver working directly on the disk masks of the side to move and the opponent.
+///
+/// The last four empty squares are handled by dedicated routines that loop over
+/// a fixed list of squares instead of generating moves from the masks.
+/// Scores are final disk differences from the point of view of the side to move.
+template<size_t N>
+class EndgameSolver
+{
+public:
+    using Geometry = BoardGeometry<N>;
+    using Bits = typename Geometry::Bits;
+
+    explicit EndgameSolver(
+        TranspositionTable& table,
+        const std::optional<Clock::time_point> deadline = std::nullopt
+    ) :
+        table(table),
+        deadline(deadline)
+    {}
+
+    /// Find the best move and the final disk difference within the given window.
+    ///
+    /// Fail-soft: a score at or below `alpha` is an upper bound
+    /// and a score at or above `beta` is a lower bound of the true score.
+    SolveResult solve_root(const Bits own, const Bits opp, int alpha, const int beta)
+    {
+        SolveResult result;
+        const Bits legal = Geometry::legal_moves(own, opp);
+        if (!any(legal)) {
+            result.score = solve(own, opp, alpha, beta, false);
+            result.nodes = nodes;
+            result.complete = !stopped;
+            return result;
+        }
+        const MoveList moves = ordered_moves(own, opp, legal, probe_move(own, opp));
+        int best = -SOLVE_INFINITY;
+        size_t best_index = moves.indices[0];
+        for (size_t i = 0; i < moves.size; ++i) {
+            const size_t index = moves.indices[i];
+            const Bits flipped = Geometry::flips(own, opp, index);
+            const Bits next_own = own | flipped | square_bit<Bits>(index);
+            const Bits next_opp = opp & ~flipped;
+            int score;
+            if (i == 0) {
+                score = -solve(next_opp, next_own, -beta, -alpha, false);
+            } else {
+                score = -solve(next_opp, next_own, -alpha - 1, -alpha, false);
+                if (score > alpha && score < beta) {
+                    score = -solve(next_opp, next_own, -beta, -score, false);
+                }
+            }
+            if (stopped) {
+                break;
+            }
+            if (score > best) {
+                best = score;
+                best_index = index;
+                if (best > alpha) {
+                    alpha = best;
+                    if (alpha >= beta) {
+                        break;
+                    }
+                }
+            }
+        }
+        result.best_move = Geometry::INDEX_SQUARES[best_index];
+        result.score = best;
+        result.nodes = nodes;
+        result.complete = !stopped;
+        return result;
+    }
+
+private:
+    struct MoveList {
+        std::array<uint8_t, Geometry::SQUARES> indices {};
+        size_t size {0};
+    };
+
+    /// Final disk difference when neither side can move.
+    static int final_score(const Bits own, const Bits opp)
+    {
+        return static_cast<int>(count(own)) - static_cast<int>(count(opp));
+    }
+
+    /// Solve a position, dispatching to the routines for the last empty squares.
+    int solve(const Bits own, const Bits opp, const int alpha, const int beta, const bool passed)
+    {
+        const Bits empty = Geometry::FULL & ~(own | opp);
+        switch (count(empty)) {
+            case 0:
+                ++nodes;
+                return final_score(own, opp);
+            case 1:
+                return solve_1(own, opp, lowest_index(empty));
+            case 2:
+                return solve_last<2>(own, opp, alpha, beta, passed, parity_ordered<2>(empty));
+            case 3:
+                return solve_last<3>(own, opp, alpha, beta, passed, parity_ordered<3>(empty));
+            case 4:
+                return solve_last<4>(own, opp, alpha, beta, passed, parity_ordered<4>(empty));
+            default:
+                return solve_many(own, opp, alpha, beta, passed, count(empty));
+        }
+    }
+
+    /// Last empty square: no choices left, only who can take it.
+    int solve_1(const Bits own, const Bits opp, const size_t index)
+    {
+        ++nodes;
+        const int own_count = static_cast<int>(count(own));
+        const int opp_count = static_cast<int>(count(opp));
+        if (const Bits flipped = Geometry::flips(own, opp, index); any(flipped)) {
+            const int flips = static_cast<int>(count(flipped));
+            return own_count + 1 + flips - (opp_count - flips);
+        }
+        ++nodes;
+        if (const Bits flipped = Geometry::flips(opp, own, index); any(flipped)) {
+            const int flips = static_cast<int>(count(flipped));
+            return own_count - flips - (opp_count + 1 + flips);
+        }
+        return own_count - opp_count;
+    }
+
+    /// Two to four empty squares: try each square of a fixed list without move generation.
+    template<size_t Empties>
+    int solve_last(
+        const Bits own,
+        const Bits opp,
+        int alpha,
+        const int beta,
+        const bool passed,
+        const std::array<uint8_t, Empties>& squares
+    )
+    {
+        ++nodes;
+        int best = -SOLVE_INFINITY;
+        for (size_t i = 0; i < Empties; ++i) {
+            const size_t index = squares[i];
+            const Bits flipped = Geometry::flips(own, opp, index);
+            if (!any(flipped)) {
+                continue;
+            }
+            const Bits next_own = own | flipped | square_bit<Bits>(index);
+            const Bits next_opp = opp & ~flipped;
+            int score;
+            if constexpr (Empties == 2) {
+                score = -solve_1(next_opp, next_own, squares[1 - i]);
+            } else {
+                std::array<uint8_t, Empties - 1> rest {};
+                for (size_t j = 0, k = 0; j < Empties; ++j) {
+                    if (j != i) {
+                        rest[k++] = squares[j];
+                    }
+                }
+                score = -solve_last<Empties - 1>(next_opp, next_own, -beta, -alpha, false, rest);
+            }
+            if (score > best) {
+                best = score;
+                if (best > alpha) {
+                    alpha = best;
+                    if (alpha >= beta) {
+                        return best;
+                    }
+                }
+            }
+        }
+        if (best == -SOLVE_INFINITY) {
+            if (passed) {
+                return final_score(own, opp);
+            }
+            return -solve_last<Empties>(opp, own, -beta, -alpha, true, squares);
+        }
+        return best;
+    }
+
+    /// More than four empty squares: principal variation search with the table and move ordering.
+    int solve_many(
+        const Bits own,
+        const Bits opp,
+        int alpha,
+        const int beta,
+        const bool passed,
+        const size_t empties
+    )
+    {
+        ++nodes;
+        if (deadline && ++clock_checks % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= *deadline) {
+            stopped = true;
+        }
+        if (stopped) {
+            return 0;
+        }
+        const Bits legal = Geometry::legal_moves(own, opp);
+        if (!any(legal)) {
+            if (passed) {
+                return final_score(own, opp);
+            }
+            return -solve(opp, own, -beta, -alpha, true);
+        }
+
+        const bool use_table = empties >= TABLE_MIN_EMPTIES;
+        const int original_alpha = alpha;
+        uint8_t hash_move = TableEntry::NO_MOVE;
+        uint64_t key = 0;
+        if (use_table) {
+            key = position_key(own, opp);
+            if (const auto entry = table.probe(key)) {
+                hash_move = entry->best_move;
+                const int score = entry->score;
+                if (entry->bound == Bound::exact
+                    || (entry->bound == Bound::lower && score >= beta)
+                    || (entry->bound == Bound::upper && score <= alpha)) {
+                    return score;
+                }
+            }
+        }
+
+        // Stability cutoff: the opponent keeps its stable disks to the end.
+        // Counting them is only worth it when the opponent has enough disks to cut.
+        constexpr int squares = static_cast<int>(Geometry::SQUARES);
+        if (empties >= STABILITY_MIN_EMPTIES
+            && squares - 2 * static_cast<int>(count(opp)) <= alpha) {
+            const int stable = static_cast<int>(count(Features<N>::stable_disks(opp, own)));
+            const int upper_bound = squares - 2 * stable;
+            if (upper_bound <= alpha) {
+                return upper_bound;
+            }
+        }
+
+        const MoveList moves = ordered_moves(own, opp, legal, hash_move);
+        int best = -SOLVE_INFINITY;
+        size_t best_index = moves.indices[0];
+        for (size_t i = 0; i < moves.size; ++i) {
+            const size_t index = moves.indices[i];
+            const Bits flipped = Geometry::flips(own, opp, index);
+            const Bits next_own = own | flipped | square_bit<Bits>(index);
+            const Bits next_opp = opp & ~flipped;
+            int score;
+            if (i == 0) {
+                score = -solve(next_opp, next_own, -beta, -alpha, false);
+            } else {
+                score = -solve(next_opp, next_own, -alpha - 1, -alpha, false);
+                if (score > alpha && score < beta) {
+                    score = -solve(next_opp, next_own, -beta, -score, false);
+                }
+            }
+            if (stopped) {
+                break;
+            }
+            if (score > best) {
+                best = score;
+                best_index = index;
+                if (best > alpha) {
+                    alpha = best;
+                    if (alpha >= beta) {
+                        break;
+                    }
+                }
+            }
+        }
+        if (stopped) {
+            return 0;
+        }
+        if (use_table) {
+            const Bound bound = best >= beta ? Bound::lower
+                : best > original_alpha      ? Bound::exact
+                                             : Bound::upper;
+            table.store(
+                key,
+                {static_cast<int16_t>(best),
+                 static_cast<uint8_t>(empties),
+                 bound,
+                 static_cast<uint8_t>(best_index)}
+            );
+        }
+        return best;
+    }
+
+    /// Order moves for searching: table move first, then the moves that leave the opponent
+    /// with the fewest replies (fastest-first), preferring squares in regions with an odd number
+    /// of empty squares (parity) and corners.
+    MoveList ordered_moves(const Bits own, const Bits opp, Bits legal, const uint8_t hash_move)
+    {
+        const Bits empty = Geometry::FULL & ~(own | opp);
+        const bool fastest_first = count(empty) >= FASTEST_FIRST_MIN_EMPTIES;
+        const Bits odd = odd_regions(empty);
+        MoveList moves;
+        std::array<int, Geometry::SQUARES> keys {};
+        while (any(legal)) {
+            const size_t index = pop_lowest(legal);
+            const Bits bit = square_bit<Bits>(index);
+            int key = 0;
+            if (index == hash_move) {
+                key = SOLVE_INFINITY;
+            } else {
+                if (any(odd & bit)) {
+                    key += 2;
+                }
+                if (any(CORNERS & bit)) {
+                    key += 4;
+                }
+                if (fastest_first) {
+                    const Bits flipped = Geometry::flips(own, opp, index);
+                    const Bits replies
+                        = Geometry::legal_moves(opp & ~flipped, own | flipped | bit);
+                    key -= 8 * static_cast<int>(count(replies));
+                }
+            }
+            size_t position = moves.size++;
+            while (position > 0 && keys[position - 1] < key) {
+                keys[position] = keys[position - 1];
+                moves.indices[position] = moves.indices[position - 1];
+                --position;
+            }
+            keys[position] = key;
+            moves.indices[position] = static_cast<uint8_t>(index);
+        }
+        return moves;
+    }
+
+    /// Empty squares listed with the squares of odd sized quadrants first.
+    ///
+    /// The last move in a region is worth having, so moving first in odd regions tends to be best.
+    template<size_t Empties>
+    static std::array<uint8_t, Empties> parity_ordered(const Bits empty)
+    {
+        const Bits odd = odd_regions(empty);
+        std::array<uint8_t, Empties> squares {};
+        size_t next = 0;
+        for (const Bits part : {empty & odd, empty & ~odd}) {
+            Bits remaining = part;
+            while (any(remaining)) {
+                squares[next++] = static_cast<uint8_t>(pop_lowest(remaining));
+            }
+        }
+        return squares;
+    }
+
+    /// Mask of all quadrants that contain an odd number of empty squares.
+    static Bits odd_regions(const Bits empty)
+    {
+        Bits odd {};
+        for (const Bits quadrant : QUADRANTS) {
+            if (count(empty & quadrant) % 2 == 1) {
+                odd |= quadrant;
+            }
+        }
+        return odd;
+    }
+
+    [[nodiscard]] uint8_t probe_move(const Bits own, const Bits opp) const
+    {
+        const auto entry = table.probe(position_key(own, opp));
+        return entry ? entry->best_move : TableEntry::NO_MOVE;
+    }
+
+    static uint64_t position_key(const Bits own, const Bits opp)
+    {
+        if constexpr (std::is_same_v<Bits, Bitboard64>) {
+            return mix(own ^ mix(opp));
+        } else {
+            return mix(own.low ^ mix(own.high ^ mix(opp.low ^ mix(opp.high))));
+        }
+    }
+
+    static constexpr std::array<Bits, 4> QUADRANTS = [] {
+        std::array<Bits, 4> quadrants {};
+        for (size_t index = 0; index < Geometry::SQUARES; ++index) {
+            const size_t x = index % N;
+            const size_t y = index / N;
+            quadrants[(x < N / 2 ? 0 : 1) + (y < N / 2 ? 0 : 2)] |= square_bit<Bits>(index);
+        }
+        return quadrants;
+    }();
+
+    static constexpr Bits CORNERS = square_bit<Bits>(0) | square_bit<Bits>(N - 1)
+        | square_bit<Bits>(N * (N - 1)) | square_bit<Bits>(N * N - 1);
+
+    TranspositionTable& table;
+    std::optional<Clock::time_point> deadline;
+    uint64_t nodes {0};
+    uint64_t clock_checks {0};
+    bool stopped {false};
+};
+
+/// Solve the position with the given score window on the size-specialised board.
+SolveResult solve_window(
+    const Board& board,
+    const Disk disk,
+    TranspositionTable& table,
+    const int alpha,
+    const int beta,
+    const std::optional<Clock::time_point> deadline = std::nullopt
+)
+{
+    return board.visit([&](const auto& sized) {
+        constexpr size_t N = std::remove_cvref_t<decltype(sized)>::SIZE;
+        EndgameSolver<N> solver(table, deadline);
+        return solver.solve_root(sized.disks(disk), sized.disks(opponent(disk)), alpha, beta);
+    });
+}
+}  // namespace
+
+/// Solve the rest of the game exactly for the given disk colour.
+///
+/// Finds the move with the best final disk difference assuming perfect play from both sides.
+/// Meant for the last moves of the game: the solve time grows exponentially
+/// with the number of empty squares. The table should not be shared with the midgame search
+/// since the scores are on a different scale.
+/// With a time limit the solve gives up at the deadline and the result is marked incomplete.
+SolveResult solve_endgame(
+    const Board& board,
+    const Disk disk,
+    TranspositionTable& table,
+    const std::optional<std::chrono::milliseconds> time
+)
+{
+    const auto start = Clock::now();
+    std::optional<Clock::time_point> deadline;
+    if (time) {
+        deadline = start + *time;
+    }
+    table.new_search();
+    SolveResult result
+        = solve_window(board, disk, table, -SOLVE_INFINITY, SOLVE_INFINITY, deadline);
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    return result;
+}
+
+/// Solve only whether the game is won, drawn or lost for the given disk colour.
+///
+/// Much faster than an exact solve: two null-window searches around zero
+/// answer "is it a win?" and, if not, "is it at least a draw?"
+/// without ever resolving the exact disk difference.
+/// The score is 1 for a win, 0 for a draw and -1 for a loss.
+/// Results share the table format of `solve_endgame`, so the two can use the same table.
+SolveResult solve_win_loss_draw(const Board& board, const Disk disk, TranspositionTable& table)
+{
+    const auto start = Clock::now();
+    table.new_search();
+    SolveResult result = solve_window(board, disk, table, 0, 1);
+    uint64_t nodes = result.nodes;
+    if (result.score >= 1) {
+        result.score = 1;
+    } else {
+        result = solve_window(board, disk, table, -1, 0);
+        nodes += result.nodes;
+        result.score = result.score >= 0 ? 0 : -1;
+    }
+    result.nodes = nodes;
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    return result;
+}
+
+}  // namespace othello
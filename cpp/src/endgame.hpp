@@ -0,0 +1,42 @@
+//==========================================================
+// Endgame header
+// Exact solver for the last moves of the game
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+#include "transposition_table.hpp"
+
+#include <chrono>
+#include <cstdint>  // uint64_t
+#include <optional>
+
+namespace othello
+{
+/// Result of an exact endgame solve.
+struct SolveResult {
+    /// Best move, or empty if the side to move has no legal moves
+    std::optional<Square> best_move;
+    /// Final disk difference with perfect play from the point of view of the solving side,
+    /// or only its sign for a win/loss/draw solve
+    int score {0};
+    /// Number of positions visited
+    uint64_t nodes {0};
+    /// Wall-clock time used
+    std::chrono::milliseconds elapsed {0};
+    /// False when the time limit ran out before the solve finished.
+    /// The move and the score are not exact then and should not be used.
+    bool complete {true};
+};
+
+SolveResult solve_endgame(
+    const Board& board,
+    Disk disk,
+    TranspositionTable& table,
+    std::optional<std::chrono::milliseconds> time = std::nullopt
+);
+SolveResult solve_win_loss_draw(const Board& board, Disk disk, TranspositionTable& table);
+
+}  // namespace othello
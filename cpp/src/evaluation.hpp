@@ -0,0 +1,298 @@
+//==========================================================
+// Evaluation header
+// Heuristic scoring of board positions for the computer player
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "features.hpp"
+#include "pattern.hpp"
+#include "sized_board.hpp"
+
+#include <algorithm>  // std::min
+#include <array>
+#include <cstdint>  // int16_t, int32_t
+#include <cstdlib>  // std::abs
+#include <vector>
+
+namespace othello
+{
+/// Score limits shared by the search and the evaluation.
+///
+/// Heuristic scores always stay strictly inside `WIN_SCORE`,
+/// so any finished game ranks above or below every unfinished one.
+constexpr int WIN_SCORE = 10000;
+constexpr int INFINITE_SCORE = WIN_SCORE + 1000;
+
+/// Square weight classes for an N x N board.
+///
+/// Corners can never be flipped, while the squares next to them tend to give a corner away.
+template<size_t N>
+struct SquareWeights {
+    using Bits = BitsFor<N>;
+
+    struct Class {
+        Bits mask {};
+        int weight {0};
+    };
+
+    static constexpr std::array<Class, 5> CLASSES = [] {
+        constexpr size_t last = N - 1;
+        const auto bit = [](const size_t x, const size_t y) { return square_bit<Bits>(y * N + x); };
+        Bits corners {};
+        Bits x_squares {};
+        Bits c_squares {};
+        Bits edges {};
+        for (const size_t x : {size_t {0}, last}) {
+            for (const size_t y : {size_t {0}, last}) {
+                corners |= bit(x, y);
+                const size_t inner_x = x == 0 ? 1 : last - 1;
+                const size_t inner_y = y == 0 ? 1 : last - 1;
+                x_squares |= bit(inner_x, inner_y);
+                c_squares |= bit(inner_x, y) | bit(x, inner_y);
+            }
+        }
+        for (size_t i = 0; i < N; ++i) {
+            edges |= bit(i, 0) | bit(i, last) | bit(0, i) | bit(last, i);
+        }
+        edges &= ~(corners | c_squares);
+        const Bits other = BoardGeometry<N>::FULL & ~(corners | x_squares | c_squares | edges);
+        return std::array<Class, 5> {{
+            {corners, 25},
+            {x_squares, -12},
+            {c_squares, -4},
+            {edges, 3},
+            {other, 1},
+        }};
+    }();
+
+    /// Weight of the class the square at the given board index belongs to.
+    static constexpr int weight_of(const size_t index)
+    {
+        const Bits bit = square_bit<Bits>(index);
+        for (const auto& [mask, weight] : CLASSES) {
+            if (any(mask & bit)) {
+                return weight;
+            }
+        }
+        return 0;
+    }
+};
+
+/// Number of game phases with their own pattern weights.
+constexpr size_t GAME_PHASES = 4;
+
+/// Pattern weight tables for an N x N board, one set for each game phase.
+///
+/// Every pattern index has a precomputed value from black's point of view.
+/// The values combine the square weights, spread over the patterns covering each square,
+/// with rules that only whole patterns can see: disks anchored to an owned corner
+/// along an edge can never be flipped, and squares next to a taken corner lose their risk.
+/// Later phases weigh disk count more and square position less.
+template<size_t N>
+class PatternWeights
+{
+public:
+    using Geometry = PatternGeometry<N>;
+    using Tables = std::array<const int16_t*, Geometry::COUNT>;
+
+    /// Table values are in units of 1 / SCALE of the evaluation score.
+    static constexpr int SCALE = 16;
+
+    /// Shared weights for the board size, generated on first use.
+    static const PatternWeights& instance()
+    {
+        static const PatternWeights weights;
+        return weights;
+    }
+
+    /// Game phase for the number of empty squares.
+    static constexpr size_t phase(const size_t empty)
+    {
+        const size_t filled = Geometry::SQUARES - empty;
+        return std::min(GAME_PHASES - 1, filled * GAME_PHASES / Geometry::SQUARES);
+    }
+
+    /// Weight table of each pattern instance for the given phase.
+    [[nodiscard]] const Tables& tables(const size_t phase) const
+    {
+        return pattern_tables[phase];
+    }
+
+    PatternWeights(const PatternWeights&) = delete;
+    PatternWeights& operator=(const PatternWeights&) = delete;
+
+private:
+    /// Square weight multiplier in quarters for each phase.
+    static constexpr std::array<int, GAME_PHASES> POSITIONAL {4, 4, 3, 2};
+    /// Value of each disk for each phase.
+    static constexpr std::array<int, GAME_PHASES> DISK {0, 0, 1, 3};
+    /// Value of each stable edge disk for each phase.
+    static constexpr std::array<int, GAME_PHASES> STABLE {8, 8, 8, 6};
+
+    PatternWeights()
+    {
+        for (size_t phase = 0; phase < GAME_PHASES; ++phase) {
+            for (size_t shape = 0; shape < PATTERN_SHAPES; ++shape) {
+                shape_tables[phase][shape] = build(phase, static_cast<PatternShape>(shape));
+            }
+            for (size_t p = 0; p < Geometry::COUNT; ++p) {
+                const auto shape = static_cast<size_t>(Geometry::PATTERNS[p].shape);
+                pattern_tables[phase][p] = shape_tables[phase][shape].data();
+            }
+        }
+    }
+
+    static std::vector<int16_t> build(const size_t phase, const PatternShape shape)
+    {
+        const size_t length = Geometry::LENGTHS[static_cast<size_t>(shape)];
+        std::vector<int16_t> table(POWERS_OF_THREE[length]);
+        std::array<int, MAX_PATTERN_SQUARES> cells {};
+        for (uint32_t index = 0; index < table.size(); ++index) {
+            uint32_t rest = index;
+            for (size_t i = 0; i < length; ++i) {
+                const uint32_t digit = rest % 3;
+                rest /= 3;
+                cells[i] = digit == 1 ? 1 : digit == 2 ? -1 : 0;
+            }
+            table[index] = static_cast<int16_t>(value(phase, shape, cells, length));
+        }
+        return table;
+    }
+
+    /// Scaled value of one pattern configuration, with +1 for black and -1 for white cells.
+    static int value(
+        const size_t phase,
+        const PatternShape shape,
+        const std::array<int, MAX_PATTERN_SQUARES>& cells,
+        const size_t length
+    )
+    {
+        int total = 0;
+        for (size_t i = 0; i < length; ++i) {
+            if (cells[i] == 0) {
+                continue;
+            }
+            const auto [x, y] = Geometry::canonical(shape, i);
+            const size_t square = y * N + x;
+            // Each pattern covering the square gets an equal share of its value
+            const int shares = static_cast<int>(Geometry::SQUARE_PATTERNS[square].size);
+            const int weight = SquareWeights<N>::weight_of(square);
+            const int square_value = POSITIONAL[phase] * weight * SCALE / 4 + DISK[phase] * SCALE;
+            total += cells[i] * square_value / shares;
+        }
+        if (shape == PatternShape::edge) {
+            total += STABLE[phase] * SCALE * stable_edge_disks(cells, length);
+        } else if (shape == PatternShape::corner_square && cells[0] != 0) {
+            // With the corner taken, the X and C squares next to it can no longer give it away
+            const int relief = 12 * cells[4] + 4 * (cells[1] + cells[3]);
+            total += POSITIONAL[phase] * relief * SCALE / 4;
+        }
+        return total;
+    }
+
+    /// Stable disk difference along an edge: runs of disks starting from an owned corner,
+    /// or every disk when the edge is full.
+    static int
+    stable_edge_disks(const std::array<int, MAX_PATTERN_SQUARES>& cells, const size_t length)
+    {
+        bool full = true;
+        int disks = 0;
+        for (size_t i = 0; i < length; ++i) {
+            full = full && cells[i] != 0;
+            disks += cells[i];
+        }
+        if (full) {
+            return disks;
+        }
+        int stable = 0;
+        size_t left = 0;
+        while (cells[left] != 0 && cells[left] == cells[0]) {
+            stable += cells[left++];
+        }
+        size_t right = length;
+        while (right > left && cells[right - 1] != 0 && cells[right - 1] == cells[length - 1]) {
+            stable += cells[--right];
+        }
+        return stable;
+    }
+
+    std::array<std::array<std::vector<int16_t>, PATTERN_SHAPES>, GAME_PHASES> shape_tables;
+    std::array<Tables, GAME_PHASES> pattern_tables {};
+};
+
+/// Pattern score of a position from black's point of view.
+///
+/// Looks up every pattern first and sums afterwards:
+/// the sum over a fixed-length aligned array compiles to vector instructions.
+template<size_t N>
+[[nodiscard]] int pattern_score(const PatternFeatures<N>& patterns, const size_t empty)
+{
+    using Weights = PatternWeights<N>;
+    constexpr size_t COUNT = PatternGeometry<N>::COUNT;
+    // Padded to a multiple of the vector width
+    constexpr size_t PADDED = (COUNT + 7) / 8 * 8;
+    const auto& tables = Weights::instance().tables(Weights::phase(empty));
+    const auto& indices = patterns.values();
+    alignas(32) std::array<int32_t, PADDED> values {};
+    for (size_t p = 0; p < COUNT; ++p) {
+        values[p] = tables[p][indices[p]];
+    }
+    int32_t total = 0;
+    for (const int32_t value : values) {
+        total += value;
+    }
+    return total / Weights::SCALE;
+}
+
+/// Heuristic score of a position from the point of view of the given disk colour,
+/// with pattern indices that are kept up to date with the board.
+/// Positive values favour `disk`.
+template<size_t N>
+[[nodiscard]] int evaluate(
+    const SizedBoard<N>& board,
+    const PatternFeatures<N>& patterns,
+    const Disk disk
+)
+{
+    const int patterns_score = pattern_score(patterns, count(board.empty()));
+    int score = disk == Disk::black ? patterns_score : -patterns_score;
+    const auto own = board.disks(disk);
+    const auto opp = board.disks(opponent(disk));
+    // Mobility: having more moves available than the opponent
+    score += 2
+        * (static_cast<int>(Features<N>::mobility(own, opp))
+           - static_cast<int>(Features<N>::mobility(opp, own)));
+    // Potential mobility: empty squares next to opponent disks may become moves later
+    score += static_cast<int>(Features<N>::potential_mobility(own, opp))
+        - static_cast<int>(Features<N>::potential_mobility(opp, own));
+    return score;
+}
+
+/// Heuristic score of a position from the point of view of the given disk colour.
+/// Computes the pattern indices from scratch.
+template<size_t N>
+[[nodiscard]] int evaluate(const SizedBoard<N>& board, const Disk disk)
+{
+    return evaluate(board, PatternFeatures<N>(board), disk);
+}
+
+/// Exact score of a finished game from the point of view of the given disk colour.
+///
+/// Ranks every win above every heuristic score and prefers larger disk margins.
+template<size_t N>
+[[nodiscard]] constexpr int final_score(const SizedBoard<N>& board, const Disk disk)
+{
+    const int difference = static_cast<int>(board.count(disk))
+        - static_cast<int>(board.count(opponent(disk)));
+    if (difference > 0) {
+        return WIN_SCORE + difference;
+    }
+    if (difference < 0) {
+        return -WIN_SCORE + difference;
+    }
+    return 0;
+}
+
+}  // namespace othello
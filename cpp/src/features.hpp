@@ -0,0 +1,280 @@
+//==========================================================
+// Features header
+// Bit-parallel evaluation features
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "bitboard.hpp"
+
+#include <array>
+#include <cstdint>  // uint16_t, uint32_t
+#include <utility>  // std::index_sequence
+#include <vector>
+
+namespace othello
+{
+/// Stable disks of every configuration of one board edge.
+///
+/// An edge square can only be flipped along the edge itself,
+/// so which edge disks can never be flipped follows from the edge alone.
+/// A disk is stable if it keeps its colour in every position reachable
+/// by playing either colour on the empty edge squares.
+/// The table has one entry for each of the 3^N configurations.
+template<size_t N>
+class EdgeStability
+{
+public:
+    /// Edge squares as bits, the first square of the edge in the lowest bit.
+    using Line = uint32_t;
+
+    static constexpr Line FULL_LINE = (Line {1} << N) - 1;
+
+    /// Shared table for the board size, generated on first use.
+    static const EdgeStability& instance()
+    {
+        static const EdgeStability table;
+        return table;
+    }
+
+    /// Own disks on the edge that can never be flipped.
+    [[nodiscard]] Line stable(const Line own, const Line opp) const
+    {
+        return stable_lines[ternary[own] + 2 * ternary[opp]];
+    }
+
+    EdgeStability(const EdgeStability&) = delete;
+    EdgeStability& operator=(const EdgeStability&) = delete;
+
+private:
+    static constexpr uint16_t UNKNOWN = 0xFFFF;
+
+    EdgeStability() : ternary(size_t {1} << N), stable_lines(POWERS, UNKNOWN)
+    {
+        // Base-3 value of a bit pattern with only the digits 0 and 1
+        for (Line bits = 0; bits <= FULL_LINE; ++bits) {
+            uint32_t value = 0;
+            for (size_t i = N; i-- > 0;) {
+                value = value * 3 + ((bits >> i) & 1U);
+            }
+            ternary[bits] = value;
+        }
+        for (Line own = 0; own <= FULL_LINE; ++own) {
+            for (Line opp = FULL_LINE & ~own;; opp = (opp - 1) & ~own & FULL_LINE) {
+                solve(own, opp);
+                if (opp == 0) {
+                    break;
+                }
+            }
+        }
+    }
+
+    /// Own disks that stay own in every position reachable from this one.
+    /// Each move leads to a position with one more disk, so memoizing the results
+    /// keeps the work linear in the number of configurations.
+    Line solve(const Line own, const Line opp)
+    {
+        uint16_t& result = stable_lines[ternary[own] + 2 * ternary[opp]];
+        if (result != UNKNOWN) {
+            return result;
+        }
+        Line stable = own;
+        const Line empty = FULL_LINE & ~(own | opp);
+        for (size_t square = 0; square < N && stable != 0; ++square) {
+            const Line bit = Line {1} << square;
+            if ((empty & bit) == 0) {
+                continue;
+            }
+            // Own move keeps the own disks, opponent move can flip them
+            const Line own_flips = line_flips(own, opp, square);
+            stable &= solve(own | bit | own_flips, opp & ~own_flips);
+            const Line opp_flips = line_flips(opp, own, square);
+            stable &= solve(own & ~opp_flips, opp | bit | opp_flips);
+        }
+        result = static_cast<uint16_t>(stable);
+        return stable;
+    }
+
+    /// Opponent disks flipped along the edge by placing an own disk on the square.
+    static Line line_flips(const Line own, const Line opp, const size_t square)
+    {
+        Line flipped = 0;
+        Line line = 0;
+        for (size_t i = square + 1; i < N && (opp >> i) & 1U; ++i) {
+            line |= Line {1} << i;
+            if (i + 1 < N && (own >> (i + 1)) & 1U) {
+                flipped |= line;
+            }
+        }
+        line = 0;
+        for (size_t i = square; i-- > 0 && (opp >> i) & 1U;) {
+            line |= Line {1} << i;
+            if (i > 0 && (own >> (i - 1)) & 1U) {
+                flipped |= line;
+            }
+        }
+        return flipped;
+    }
+
+    static constexpr size_t POWERS = [] {
+        size_t power = 1;
+        for (size_t i = 0; i < N; ++i) {
+            power *= 3;
+        }
+        return power;
+    }();
+
+    std::vector<uint32_t> ternary;
+    std::vector<uint16_t> stable_lines;
+};
+
+/// Evaluation features computed with shifts, masks and popcounts on an N x N board,
+/// without generating move lists.
+template<size_t N>
+struct Features {
+    using Geometry = BoardGeometry<N>;
+    using Bits = typename Geometry::Bits;
+    using Edges = EdgeStability<N>;
+
+    /// Number of legal moves.
+    [[nodiscard]] static constexpr size_t mobility(const Bits own, const Bits opp)
+    {
+        return count(Geometry::legal_moves(own, opp));
+    }
+
+    /// Squares next to any of the given squares.
+    [[nodiscard]] static constexpr Bits neighbours(const Bits squares)
+    {
+        Bits result {};
+        for_each_direction([&](auto direction) {
+            result |= Geometry::template shift<decltype(direction)::value>(squares);
+        });
+        return result;
+    }
+
+    /// Empty squares next to opponent disks, an estimate of future mobility.
+    [[nodiscard]] static constexpr size_t potential_mobility(const Bits own, const Bits opp)
+    {
+        const Bits empty = Geometry::FULL & ~(own | opp);
+        return count(neighbours(opp) & empty);
+    }
+
+    /// Own disks next to an empty square. Frontier disks tend to give the opponent moves.
+    [[nodiscard]] static constexpr size_t frontier(const Bits own, const Bits opp)
+    {
+        const Bits empty = Geometry::FULL & ~(own | opp);
+        return count(own & neighbours(empty));
+    }
+
+    /// Own disks that can never be flipped.
+    ///
+    /// Edge disks come from the edge stability table. An inner disk is stable when along
+    /// each of the four lines through it the line is full or a neighbour is a stable own disk.
+    /// The result is a lower bound: some stable disks may be missed, but none are wrong.
+    [[nodiscard]] static Bits stable_disks(const Bits own, const Bits opp)
+    {
+        const Edges& edges = Edges::instance();
+        Bits stable {};
+        [&]<size_t... Edge>(std::index_sequence<Edge...>) {
+            ((stable |= from_line<Edge>(edges.stable(to_line<Edge>(own), to_line<Edge>(opp))))
+             , ...);
+        }(std::make_index_sequence<EDGES.size()> {});
+        // Squares on full lines along each axis: spread the empty squares along the axis
+        const Bits empty = Geometry::FULL & ~(own | opp);
+        std::array<Bits, AXES> full {};
+        for_each_direction([&](auto direction) {
+            constexpr size_t D = decltype(direction)::value;
+            if constexpr (D < AXES) {
+                Bits reach = empty;
+                for (size_t i = 1; i < N; ++i) {
+                    reach |= Geometry::template shift<D>(reach)
+                        | Geometry::template shift<OPPOSITE[D]>(reach);
+                }
+                full[D] = ~reach;
+            }
+        });
+        const Bits inner = own & INNER;
+        Bits candidates = inner & full[0] & full[1] & full[2] & full[3];
+        stable |= candidates;
+        // Grow the stable region until it stops changing
+        do {
+            candidates = inner & ~stable;
+            for_each_direction([&](auto direction) {
+                constexpr size_t D = decltype(direction)::value;
+                if constexpr (D < AXES) {
+                    candidates &= full[D] | Geometry::template shift<D>(stable)
+                        | Geometry::template shift<OPPOSITE[D]>(stable);
+                }
+            });
+            stable |= candidates;
+        } while (any(candidates));
+        return stable;
+    }
+
+private:
+    using Line = typename Edges::Line;
+    using EdgeSquares = std::array<size_t, N>;
+
+    /// The first four directions all lie on different lines,
+    /// so each of them stands for one axis together with its opposite direction.
+    static constexpr size_t AXES = 4;
+
+    /// Index of the opposite of each direction.
+    static constexpr std::array<size_t, 8> OPPOSITE = [] {
+        std::array<size_t, 8> opposite {};
+        for (size_t direction = 0; direction < STEP_DIRECTIONS.size(); ++direction) {
+            for (size_t other = 0; other < STEP_DIRECTIONS.size(); ++other) {
+                if (STEP_DIRECTIONS[other].x == -STEP_DIRECTIONS[direction].x
+                    && STEP_DIRECTIONS[other].y == -STEP_DIRECTIONS[direction].y) {
+                    opposite[direction] = other;
+                }
+            }
+        }
+        return opposite;
+    }();
+
+    /// Squares of the four edges, each starting from a corner.
+    static constexpr std::array<EdgeSquares, 4> EDGES = [] {
+        std::array<EdgeSquares, 4> edges {};
+        for (size_t i = 0; i < N; ++i) {
+            edges[0][i] = i;
+            edges[1][i] = (N - 1) * N + i;
+            edges[2][i] = i * N;
+            edges[3][i] = i * N + N - 1;
+        }
+        return edges;
+    }();
+
+    /// Squares that are not on any edge.
+    static constexpr Bits INNER = [] {
+        Bits inner {};
+        for (size_t y = 1; y + 1 < N; ++y) {
+            for (size_t x = 1; x + 1 < N; ++x) {
+                inner |= square_bit<Bits>(y * N + x);
+            }
+        }
+        return inner;
+    }();
+
+    /// Disks on one edge as a line, unrolled so that every square mask is a constant.
+    template<size_t Edge>
+    static constexpr Line to_line(const Bits disks)
+    {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return ((any(disks & square_bit<Bits>(EDGES[Edge][I])) ? Line {1} << I : Line {0})
+                    | ...);
+        }(std::make_index_sequence<N> {});
+    }
+
+    /// Board squares of a line on one edge.
+    template<size_t Edge>
+    static constexpr Bits from_line(const Line line)
+    {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return ((((line >> I) & 1U) != 0 ? square_bit<Bits>(EDGES[Edge][I]) : Bits {}) | ...);
+        }(std::make_index_sequence<N> {});
+    }
+};
+
+}  // namespace othello
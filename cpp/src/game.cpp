@@ -0,0 +1,94 @@
+//==========================================================
+// Game source
+// Game state and rules without any input or output
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "game.hpp"
+
+#include <stdexcept>
+#include <type_traits>  // std::remove_cvref_t
+
+namespace othello
+{
+Game::Game(const size_t board_size) : state(board_size) {}
+
+/// Current board.
+const Board& Game::board() const
+{
+    return state;
+}
+
+/// The disk colour whose turn it is.
+Disk Game::side_to_move() const
+{
+    return state.side_to_move();
+}
+
+/// Legal moves for the side to move. Empty means the side has to pass.
+std::vector<Move> Game::legal_moves() const
+{
+    return state.possible_moves(state.side_to_move());
+}
+
+/// Play a move for the side to move.
+/// Throws if the move is not legal in the current position.
+void Game::apply(const Move& move)
+{
+    const bool legal = move.disk == state.side_to_move()
+        && state.visit([&](const auto& sized) {
+               using Sized = std::remove_cvref_t<decltype(sized)>;
+               return move.square.x >= 0 && move.square.y >= 0
+                   && static_cast<size_t>(move.square.x) < Sized::SIZE
+                   && static_cast<size_t>(move.square.y) < Sized::SIZE
+                   && any(sized.legal_moves(move.disk)
+                          & square_bit<typename Sized::Bits>(Sized::square_index(move.square)));
+           });
+    if (!legal) {
+        throw std::invalid_argument("Illegal move");
+    }
+    state.place_disk(move);
+}
+
+/// Skip the turn of the side to move.
+void Game::pass()
+{
+    state.pass();
+}
+
+/// Play one turn for the side to move with the given computer player.
+/// The computer passes when it has no legal moves.
+Turn Game::step(Computer& computer)
+{
+    const Disk disk = state.side_to_move();
+    if (computer.disk() != disk) {
+        throw std::invalid_argument("Computer player does not have the turn");
+    }
+    const auto moves = legal_moves();
+    if (moves.empty()) {
+        state.pass();
+        return {disk, std::nullopt};
+    }
+    const auto chosen = computer.choose_move(state, moves);
+    state.place_disk(chosen.move);
+    return {disk, chosen.move};
+}
+
+/// Returns true when neither side has a legal move.
+bool Game::over() const
+{
+    return state.visit([](const auto& sized) {
+        return !any(sized.legal_moves(Disk::black)) && !any(sized.legal_moves(Disk::white));
+    });
+}
+
+/// Disk counts of both sides.
+GameResult Game::result() const
+{
+    return state.visit([](const auto& sized) {
+        return GameResult {sized.count(Disk::black), sized.count(Disk::white)};
+    });
+}
+
+}  // namespace othello
@@ -0,0 +1,69 @@
+//==========================================================
+// Game header
+// Game state and rules without any input or output
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+#include "computer.hpp"
+
+#include <cstddef>  // size_t
+#include <optional>
+#include <vector>
+
+namespace othello
+{
+/// One turn of a game: the move played, or empty for a pass.
+struct Turn {
+    Disk disk;
+    std::optional<Move> move;
+};
+
+/// Final disk counts of a game.
+struct GameResult {
+    size_t black {0};
+    size_t white {0};
+
+    /// The winning disk colour. Empty indicates a draw.
+    [[nodiscard]] constexpr Disk winner() const
+    {
+        if (black == white) {
+            return Disk::empty;
+        }
+        return black > white ? Disk::black : Disk::white;
+    }
+
+    /// Final disk difference from the point of view of black.
+    [[nodiscard]] constexpr int margin() const
+    {
+        return static_cast<int>(black) - static_cast<int>(white);
+    }
+};
+
+/// Headless Othello game.
+///
+/// Keeps the board and the side to move and applies the rules,
+/// without formatting strings or touching the terminal.
+/// The command line game is a front end on top of this,
+/// and batch or embedded use can drive it directly.
+class Game
+{
+public:
+    explicit Game(size_t board_size);
+
+    [[nodiscard]] const Board& board() const;
+    [[nodiscard]] Disk side_to_move() const;
+    [[nodiscard]] std::vector<Move> legal_moves() const;
+    void apply(const Move& move);
+    void pass();
+    Turn step(Computer& computer);
+    [[nodiscard]] bool over() const;
+    [[nodiscard]] GameResult result() const;
+
+private:
+    Board state;
+};
+
+}  // namespace othello
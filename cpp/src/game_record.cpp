@@ -0,0 +1,229 @@
+//==========================================================
+// Game record source
+// Compact binary format for storing played games
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "game_record.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>  // std::ranges::find_if
+#include <array>
+#include <cstring>  // std::memcpy
+#include <limits>
+#include <stdexcept>
+#include <utility>  // std::move
+
+namespace othello
+{
+namespace
+{
+constexpr std::array<char, 8> RECORD_MAGIC {'O', 'T', 'H', 'G', 'A', 'M', 'E', 'S'};
+constexpr uint32_t RECORD_VERSION = 1;
+/// Records are collected in memory and written to the file in chunks of this size.
+constexpr size_t WRITE_BUFFER_SIZE = size_t {1} << 20;
+/// Board size, number of turns and seed in front of the turns of each record.
+constexpr size_t RECORD_HEADER_SIZE = 1 + 2 + 8;
+
+/// File header in front of the records.
+struct RecordFileHeader {
+    std::array<char, 8> magic {RECORD_MAGIC};
+    uint32_t version {RECORD_VERSION};
+    uint32_t reserved {0};
+};
+
+/// Append an unsigned value to the buffer as little-endian bytes.
+template<typename T>
+void append_bytes(std::vector<char>& buffer, T value)
+{
+    for (size_t byte = 0; byte < sizeof(T); ++byte) {
+        buffer.push_back(static_cast<char>(value & 0xFF));
+        value >>= 8;
+    }
+}
+
+/// Read an unsigned little-endian value.
+template<typename T>
+T read_bytes(const char* data)
+{
+    T value {0};
+    for (size_t byte = sizeof(T); byte > 0; --byte) {
+        value = static_cast<T>(value << 8) | static_cast<unsigned char>(data[byte - 1]);
+    }
+    return value;
+}
+
+bool valid_header(const RecordFileHeader& header)
+{
+    return header.magic == RECORD_MAGIC && header.version == RECORD_VERSION;
+}
+}  // namespace
+
+/// Append one turn of the game.
+void GameRecord::add(const Turn& turn)
+{
+    if (!turn.move.has_value()) {
+        turns.push_back(PASS);
+        return;
+    }
+    const auto& square = turn.move->square;
+    const size_t index = static_cast<size_t>(square.y) * board_size + static_cast<size_t>(square.x);
+    turns.push_back(static_cast<uint8_t>(index));
+}
+
+/// Rebuild the game log with the move and the board after it for every placed disk,
+/// in the same form as the log of the command line game.
+std::vector<std::string> GameRecord::log() const
+{
+    std::vector<std::string> lines;
+    GameLogReplay replay(*this);
+    while (auto line = replay.next()) {
+        lines.push_back(std::move(*line));
+    }
+    return lines;
+}
+
+GameLogReplay::GameLogReplay(const GameRecord& record) : record(record), board(record.board_size)
+{}
+
+/// Replay up to the next placed disk and return its log line,
+/// or nothing when all the turns have been replayed.
+std::optional<std::string> GameLogReplay::next()
+{
+    const size_t size = record.board_size;
+    while (index < record.turns.size()) {
+        const uint8_t turn = record.turns[index++];
+        if (turn == GameRecord::PASS) {
+            board.pass();
+            continue;
+        }
+        const Square square(static_cast<int>(turn % size), static_cast<int>(turn / size));
+        const auto moves = board.possible_moves(board.side_to_move());
+        const auto move = std::ranges::find_if(moves, [&](const Move& candidate) {
+            return candidate.square == square;
+        });
+        if (move == moves.end()) {
+            throw std::runtime_error(fmt::format("Invalid move {} in game record", square));
+        }
+        board.place_disk(*move);
+        return fmt::format("{};{}", move->log_entry(), board.log_entry());
+    }
+    return std::nullopt;
+}
+
+/// Open the file for appending, writing the file header if the file is new.
+GameRecordWriter::GameRecordWriter(const std::filesystem::path& path) : path(path)
+{
+    const bool exists = std::filesystem::exists(path) && std::filesystem::file_size(path) > 0;
+    if (exists) {
+        RecordFileHeader header;
+        std::ifstream existing(path, std::ios::binary);
+        existing.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!existing || !valid_header(header)) {
+            throw std::runtime_error(fmt::format("Invalid game record file: {}", path.string()));
+        }
+    }
+    file.open(path, std::ios::binary | std::ios::app);
+    if (!file) {
+        throw std::runtime_error(fmt::format("Failed to open file: {}", path.string()));
+    }
+    buffer.reserve(WRITE_BUFFER_SIZE);
+    if (!exists) {
+        const RecordFileHeader header;
+        const auto* bytes = reinterpret_cast<const char*>(&header);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(header));
+    }
+}
+
+/// Write out the records still in the buffer.
+/// Errors are only reported by calling `flush` before the writer goes away.
+GameRecordWriter::~GameRecordWriter()
+{
+    try {
+        flush();
+    } catch (...) {
+        // Destructors must not throw
+    }
+}
+
+/// Add a record to the buffer, writing the buffer to the file when it fills up.
+void GameRecordWriter::write(const GameRecord& record)
+{
+    if (record.board_size < MIN_BOARD_SIZE || record.board_size > MAX_BOARD_SIZE
+        || record.turns.size() > std::numeric_limits<uint16_t>::max()) {
+        throw std::invalid_argument("Game record does not fit the file format");
+    }
+    append_bytes(buffer, static_cast<uint8_t>(record.board_size));
+    append_bytes(buffer, static_cast<uint16_t>(record.turns.size()));
+    append_bytes(buffer, record.seed);
+    buffer.insert(buffer.end(), record.turns.begin(), record.turns.end());
+    ++count;
+    if (buffer.size() >= WRITE_BUFFER_SIZE) {
+        flush();
+    }
+}
+
+/// Write the buffered records to the file.
+void GameRecordWriter::flush()
+{
+    if (buffer.empty()) {
+        return;
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.flush();
+    if (!file) {
+        throw std::runtime_error(fmt::format("Failed to write file: {}", path.string()));
+    }
+    buffer.clear();
+}
+
+/// Number of records written with this writer.
+size_t GameRecordWriter::size() const
+{
+    return count;
+}
+
+/// Map the file into memory and check its header.
+GameRecordReader::GameRecordReader(const std::filesystem::path& path) : path(path), file(path)
+{
+    RecordFileHeader header;
+    if (file.size() < sizeof(header)) {
+        throw std::runtime_error(fmt::format("Invalid game record file: {}", path.string()));
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (!valid_header(header)) {
+        throw std::runtime_error(fmt::format("Invalid game record file: {}", path.string()));
+    }
+    offset = sizeof(header);
+}
+
+/// The next record in the file, or nothing at the end of the file.
+std::optional<GameRecord> GameRecordReader::next()
+{
+    if (offset == file.size()) {
+        return std::nullopt;
+    }
+    const char* data = file.data() + offset;
+    const size_t left = file.size() - offset;
+    if (left < RECORD_HEADER_SIZE) {
+        throw std::runtime_error(fmt::format("Truncated game record in {}", path.string()));
+    }
+    GameRecord record;
+    record.board_size = read_bytes<uint8_t>(data);
+    const size_t turns = read_bytes<uint16_t>(data + 1);
+    record.seed = read_bytes<uint64_t>(data + 3);
+    if (record.board_size < MIN_BOARD_SIZE || record.board_size > MAX_BOARD_SIZE) {
+        throw std::runtime_error(fmt::format("Invalid game record in {}", path.string()));
+    }
+    if (left < RECORD_HEADER_SIZE + turns) {
+        throw std::runtime_error(fmt::format("Truncated game record in {}", path.string()));
+    }
+    const auto* begin = reinterpret_cast<const uint8_t*>(data + RECORD_HEADER_SIZE);
+    record.turns.assign(begin, begin + turns);
+    offset += RECORD_HEADER_SIZE + turns;
+    return record;
+}
+
+}  // namespace othello
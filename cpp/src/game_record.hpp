@@ -0,0 +1,101 @@
+//==========================================================
+// Game record header
+// Compact binary format for storing played games
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+#include "game.hpp"
+#include "mapped_file.hpp"
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint64_t
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace othello
+{
+/// One played game stored as one byte per turn.
+///
+/// Each turn is the board index of the placed disk, or `PASS`.
+/// The colour and the flipped disks follow from replaying the moves from the start position,
+/// so the full text log can be rebuilt when it is needed.
+struct GameRecord {
+    /// Turn value for a pass
+    static constexpr uint8_t PASS = 0xFF;
+
+    size_t board_size {DEFAULT_BOARD_SIZE};
+    /// Seed the game was played with
+    uint64_t seed {0};
+    std::vector<uint8_t> turns;
+
+    void add(const Turn& turn);
+    [[nodiscard]] std::vector<std::string> log() const;
+
+    bool operator==(const GameRecord& other) const = default;
+};
+
+/// Rebuilds the log lines of a game record one at a time by replaying its moves.
+///
+/// Only the current board is kept, so a log can be printed or hashed
+/// without building all of its lines first.
+class GameLogReplay
+{
+public:
+    explicit GameLogReplay(const GameRecord& record);
+
+    [[nodiscard]] std::optional<std::string> next();
+
+private:
+    const GameRecord& record;
+    Board board;
+    size_t index {0};
+};
+
+/// Appends game records to a file through an in-memory buffer.
+///
+/// The file starts with a header, followed by the records back to back.
+/// Each record is the board size, the number of turns and the seed, then the turns.
+/// Opening an existing file continues after its last record.
+class GameRecordWriter
+{
+public:
+    explicit GameRecordWriter(const std::filesystem::path& path);
+    ~GameRecordWriter();
+
+    GameRecordWriter(const GameRecordWriter&) = delete;
+    GameRecordWriter& operator=(const GameRecordWriter&) = delete;
+    GameRecordWriter(GameRecordWriter&&) = delete;
+    GameRecordWriter& operator=(GameRecordWriter&&) = delete;
+
+    void write(const GameRecord& record);
+    void flush();
+    [[nodiscard]] size_t size() const;
+
+private:
+    std::filesystem::path path;
+    std::ofstream file;
+    std::vector<char> buffer;
+    size_t count {0};
+};
+
+/// Reads game records one at a time from a file mapped into memory.
+class GameRecordReader
+{
+public:
+    explicit GameRecordReader(const std::filesystem::path& path);
+
+    [[nodiscard]] std::optional<GameRecord> next();
+
+private:
+    std::filesystem::path path;
+    MappedFile file;
+    size_t offset {0};
+};
+
+}  // namespace othello
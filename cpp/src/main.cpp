@@ -8,10 +8,15 @@
 
 #include "colorprint.hpp"
 #include "cxxopts.hpp"
+#include "endgame.hpp"
 #include "othello.hpp"
+#include "perft.hpp"
+#include "self_play.hpp"
 #include "version.hpp"
 
+#include <iostream>  // std::cin
 #include <optional>
+#include <string>  // std::getline, std::to_string
 
 inline cxxopts::Options cli_arguments()
 {
@@ -38,8 +43,24 @@ inline cxxopts::Options cli_arguments()
         ("a,autoplay", "Enable autoplay mode with computer control", cxxopts::value<bool>())
         ("c,check", "Autoplay and only print result", cxxopts::value<bool>())
         ("d,default", "Play with default settings", cxxopts::value<bool>())
+        ("depth", "Fixed computer search depth, 0 searches by time", cxxopts::value<int>()->default_value("0"))
+        ("move-time", "Computer time per move in ms, 0 for random 1-2 s", cxxopts::value<int>()->default_value("0"))
+        ("game-time", "Computer time per game in seconds, 0 for no limit", cxxopts::value<int>()->default_value("0"))
+        ("threads", "Number of computer search threads, or games played at the same time with --games", cxxopts::value<size_t>()->default_value("1"))
+        ("engine", "Computer search engine: alphabeta or mcts", cxxopts::value<std::string>()->default_value("alphabeta"))
+        ("exploration", "Exploration constant for mcts", cxxopts::value<double>()->default_value("1.4"))
+        ("book", "Opening book file to play from before searching", cxxopts::value<std::string>())
+        ("tablebase", "Tablebase file for perfect play in the positions it covers", cxxopts::value<std::string>())
+        ("endgame", "Empty squares left when computer solves the game exactly, 0 to disable",
+            cxxopts::value<size_t>()->default_value(std::to_string(othello::DEFAULT_ENDGAME_EMPTIES)))
+        ("games", "Play this many computer games in parallel without output and print the results", cxxopts::value<size_t>())
+        ("seed", "Seed for the random openings of --games", cxxopts::value<uint64_t>()->default_value("0"))
+        ("record", "Append the games played with --games to this game record file", cxxopts::value<std::string>())
         ("l,log", "Show game log at the end", cxxopts::value<bool>())
         ("n,no-helpers", "Hide disk placement hints", cxxopts::value<bool>())
+        ("solve", "Solve a position like B:____BBB__BW_____ and exit, - reads positions from stdin", cxxopts::value<std::string>())
+        ("perft", "Count the leaf positions this many plies from the start position and exit", cxxopts::value<int>())
+        ("wld", "Only solve win, loss or draw instead of the exact disk difference", cxxopts::value<bool>())
         ("t,test", "Enable test mode with deterministic computer moves", cxxopts::value<bool>())
         ("v,version", "Print version and exit", cxxopts::value<bool>())
         ("h,help", "Print help and exit", cxxopts::value<bool>());
@@ -49,14 +70,32 @@ inline cxxopts::Options cli_arguments()
     return options;
 }
 
+/// Parse the search engine name.
+inline othello::Engine parse_engine(const std::string& name)
+{
+    for (const auto engine : {othello::Engine::alpha_beta, othello::Engine::mcts}) {
+        if (name == othello::engine_name(engine)) {
+            return engine;
+        }
+    }
+    throw std::invalid_argument(fmt::format("Unknown search engine: {}", name));
+}
+
 /// Command line arguments
 struct Args {
     std::optional<size_t> size;
     bool autoplay;
     bool check;
     bool use_defaults;
+    othello::SearchSettings search;
+    std::optional<size_t> games;
+    uint64_t seed;
+    std::optional<std::string> record;
     bool log;
     bool no_helpers;
+    std::optional<std::string> solve;
+    std::optional<int> perft;
+    bool wld;
     bool test;
     bool version;
     bool help;
@@ -73,8 +112,35 @@ struct Args {
         autoplay = parsed_args["autoplay"].as<bool>();
         check = parsed_args["check"].as<bool>();
         use_defaults = parsed_args["default"].as<bool>();
+        search.depth = parsed_args["depth"].as<int>();
+        search.move_time = parsed_args["move-time"].as<int>();
+        search.game_time = parsed_args["game-time"].as<int>();
+        search.threads = parsed_args["threads"].as<size_t>();
+        search.endgame = parsed_args["endgame"].as<size_t>();
+        search.engine = parse_engine(parsed_args["engine"].as<std::string>());
+        search.exploration = parsed_args["exploration"].as<double>();
+        if (parsed_args.count("book") > 0) {
+            search.book = parsed_args["book"].as<std::string>();
+        }
+        if (parsed_args.count("tablebase") > 0) {
+            search.tablebase = parsed_args["tablebase"].as<std::string>();
+        }
+        if (parsed_args.count("games") > 0) {
+            games = parsed_args["games"].as<size_t>();
+        }
+        seed = parsed_args["seed"].as<uint64_t>();
+        if (parsed_args.count("record") > 0) {
+            record = parsed_args["record"].as<std::string>();
+        }
         log = parsed_args["log"].as<bool>();
         no_helpers = parsed_args["no-helpers"].as<bool>();
+        if (parsed_args.count("solve") > 0) {
+            solve = parsed_args["solve"].as<std::string>();
+        }
+        if (parsed_args.count("perft") > 0) {
+            perft = parsed_args["perft"].as<int>();
+        }
+        wld = parsed_args["wld"].as<bool>();
         test = parsed_args["test"].as<bool>();
         version = parsed_args["version"].as<bool>();
         help = parsed_args["help"].as<bool>();
@@ -94,13 +160,103 @@ size_t resolve_board_size(const Args& args)
         fmt::println("Using board size: {}", size);
         return size;
     }
-    if (args.autoplay || args.use_defaults) {
+    if (args.autoplay || args.use_defaults || args.games.has_value()) {
         return othello::DEFAULT_BOARD_SIZE;
     }
     // Otherwise ask user for board size
     return othello::Othello::get_board_size();
 }
 
+/// Solve one position and print the best move and the result.
+void solve_position(
+    const std::string& position,
+    const bool win_loss_draw,
+    othello::TranspositionTable& table
+)
+{
+    const auto board = othello::Board::from_position(position);
+    const auto disk = board.side_to_move();
+    const auto result = win_loss_draw ? othello::solve_win_loss_draw(board, disk, table)
+                                      : othello::solve_endgame(board, disk, table);
+    const std::string best_move
+        = result.best_move ? othello::to_string(*result.best_move) : std::string("pass");
+    std::string score;
+    if (win_loss_draw) {
+        score = result.score > 0 ? "win" : result.score < 0 ? "loss" : "draw";
+    } else {
+        score = fmt::format("{:+}", result.score);
+    }
+    fmt::println("{} {} {}", position, best_move, score);
+}
+
+/// Solve the position given on the command line, or each line read from stdin for `-`.
+void solve_positions(const Args& args)
+{
+    othello::TranspositionTable table;
+    if (args.solve.value() != "-") {
+        solve_position(args.solve.value(), args.wld, table);
+        return;
+    }
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (!line.empty()) {
+            solve_position(line, args.wld, table);
+        }
+    }
+}
+
+/// Count the game tree leaves from the start position and print the move generation speed.
+void run_perft(const Args& args)
+{
+    const size_t size = args.size.value_or(othello::DEFAULT_BOARD_SIZE);
+    const int depth = args.perft.value();
+    const auto result = othello::perft(size, depth);
+    fmt::println(
+        "Perft {} on {}x{}: {} nodes in {} ms, {} nodes/s",
+        depth,
+        size,
+        size,
+        result.nodes,
+        result.elapsed.count(),
+        result.nodes_per_second()
+    );
+}
+
+/// Play a batch of computer games and print the aggregated results.
+void run_self_play(const othello::Settings& settings, const Args& args)
+{
+    const othello::SelfPlaySettings self_play_settings {
+        settings, args.games.value(), args.search.threads, args.seed, args.record.value_or("")
+    };
+    const auto result = othello::self_play(self_play_settings);
+    const auto percent = [&](const size_t count) {
+        return result.games > 0
+            ? 100.0 * static_cast<double>(count) / static_cast<double>(result.games)
+            : 0.0;
+    };
+    fmt::println(
+        "Played {} games in {} ms with {} threads, {:.1f} games/s",
+        result.games,
+        result.elapsed.count(),
+        args.search.threads,
+        result.games_per_second()
+    );
+    fmt::println(
+        "Black wins {} ({:.1f}%), draws {} ({:.1f}%), white wins {} ({:.1f}%)",
+        result.black_wins,
+        percent(result.black_wins),
+        result.draws,
+        percent(result.draws),
+        result.white_wins,
+        percent(result.white_wins)
+    );
+    fmt::println(
+        "Average margin {:.2f}, black {:+.2f}",
+        result.average_margin(),
+        result.average_black_margin()
+    );
+}
+
 int main(const int argc, const char* argv[])
 {
     try {
@@ -114,6 +270,14 @@ int main(const int argc, const char* argv[])
             fmt::print("{}", args.usage);
             return 0;
         }
+        if (args.solve.has_value()) {
+            solve_positions(args);
+            return 0;
+        }
+        if (args.perft.has_value()) {
+            run_perft(args);
+            return 0;
+        }
         // `autoplay` conflicts with `default`
         if (args.autoplay && args.use_defaults) {
             print_error("the argument '-a/--autoplay' cannot be used with '-d/--default'");
@@ -123,6 +287,20 @@ int main(const int argc, const char* argv[])
         print_green_bold("OTHELLO GAME - C++\n");
 
         const size_t board_size = resolve_board_size(args);
+        if (args.search.depth < 0 || args.search.depth > othello::MAX_SEARCH_DEPTH) {
+            throw std::invalid_argument(
+                fmt::format("Unsupported search depth: {}", args.search.depth)
+            );
+        }
+        if (args.search.move_time < 0 || args.search.game_time < 0) {
+            throw std::invalid_argument("Search time can't be negative");
+        }
+        if (args.search.threads == 0) {
+            throw std::invalid_argument("Search needs at least one thread");
+        }
+        if (args.search.engine == othello::Engine::mcts && args.search.depth > 0) {
+            throw std::invalid_argument("Monte Carlo tree search does not use a search depth");
+        }
 
         const othello::Settings settings(
             board_size,
@@ -131,9 +309,14 @@ int main(const int argc, const char* argv[])
             !args.no_helpers,
             args.log || args.check,
             args.test || args.check,
-            args.use_defaults
+            args.use_defaults,
+            args.search
         );
 
+        if (args.games.has_value()) {
+            run_self_play(settings, args);
+            return 0;
+        }
         othello::Othello(settings).play();
     } catch (const cxxopts::exceptions::exception& e) {
         print_error(e.what());
@@ -0,0 +1,129 @@
+//==========================================================
+// Mapped file source
+// Read-only memory mapping of a data file
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "mapped_file.hpp"
+
+#include <fmt/format.h>
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace othello
+{
+/// Map the whole file into memory.
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+    file_handle = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        file_handle = nullptr;
+        throw std::runtime_error(fmt::format("Failed to open file: {}", path.string()));
+    }
+    LARGE_INTEGER file_size {};
+    if (!GetFileSizeEx(file_handle, &file_size)) {
+        unmap();
+        throw std::runtime_error(fmt::format("Failed to read file: {}", path.string()));
+    }
+    mapping_size = static_cast<size_t>(file_size.QuadPart);
+    if (mapping_size > 0) {
+        mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle != nullptr) {
+            mapping = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+        }
+        if (mapping == nullptr) {
+            unmap();
+            throw std::runtime_error(fmt::format("Failed to map file: {}", path.string()));
+        }
+    }
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error(fmt::format("Failed to open file: {}", path.string()));
+    }
+    struct stat info {};
+    if (::fstat(file, &info) != 0) {
+        ::close(file);
+        throw std::runtime_error(fmt::format("Failed to read file: {}", path.string()));
+    }
+    mapping_size = static_cast<size_t>(info.st_size);
+    if (mapping_size > 0) {
+        void* data = ::mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, file, 0);
+        if (data == MAP_FAILED) {
+            ::close(file);
+            throw std::runtime_error(fmt::format("Failed to map file: {}", path.string()));
+        }
+        mapping = data;
+    }
+    // The mapping stays valid after the file is closed
+    ::close(file);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+/// Start of the file contents, aligned to the page size.
+const char* MappedFile::data() const
+{
+    return static_cast<const char*>(mapping);
+}
+
+/// File size in bytes.
+size_t MappedFile::size() const
+{
+    return mapping_size;
+}
+
+/// Release the mapping and the file handles.
+void MappedFile::unmap()
+{
+#ifdef _WIN32
+    if (mapping != nullptr) {
+        UnmapViewOfFile(mapping);
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle != nullptr) {
+        CloseHandle(file_handle);
+    }
+    file_handle = nullptr;
+    mapping_handle = nullptr;
+#else
+    if (mapping != nullptr) {
+        ::munmap(const_cast<void*>(mapping), mapping_size);
+    }
+#endif
+    mapping = nullptr;
+    mapping_size = 0;
+}
+
+}  // namespace othello
@@ -0,0 +1,44 @@
+//==========================================================
+// Mapped file header
+// Read-only memory mapping of a data file
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <filesystem>
+
+namespace othello
+{
+/// Whole file mapped read-only into memory.
+///
+/// Opening the file reads nothing up front: pages are loaded on first access,
+/// and processes mapping the same file share one copy of it in the page cache.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    [[nodiscard]] const char* data() const;
+    [[nodiscard]] size_t size() const;
+
+private:
+    void unmap();
+
+    const void* mapping {nullptr};
+    size_t mapping_size {0};
+#ifdef _WIN32
+    void* file_handle {nullptr};
+    void* mapping_handle {nullptr};
+#endif
+};
+
+}  // namespace othello
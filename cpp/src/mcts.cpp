@@ -0,0 +1,307 @@
+//==========================================================
+// Monte Carlo tree search source
+// Playout based computer player search
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "mcts.hpp"
+
+#include "utils.hpp"
+
+#include <array>
+#include <atomic>
+#include <cmath>  // std::log, std::sqrt
+#include <limits>
+#include <memory>  // std::unique_ptr
+#include <stdexcept>
+#include <thread>       // std::jthread
+#include <type_traits>  // std::remove_cvref_t
+#include <utility>      // std::swap
+#include <vector>
+
+namespace othello
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// Maximum number of tree nodes for one search. The tree stops growing when full.
+constexpr uint32_t NODE_CAPACITY = 1 << 21;
+/// How many playouts each thread runs between checks of the clock.
+constexpr uint64_t CLOCK_CHECK_INTERVAL = 16;
+/// Move index for a pass.
+constexpr uint8_t PASS = 0xFF;
+
+/// Playout outcomes in half points so that draws stay integers.
+constexpr uint32_t WIN = 2;
+constexpr uint32_t DRAW = 1;
+
+/// Tree node shared by all search threads.
+///
+/// Statistics are from the point of view of the player who made the move leading to the node.
+/// A thread adds a visit when it passes through the node and only adds the value
+/// after the playout has finished, so a pending playout counts as a loss (virtual loss).
+/// That steers the other threads to different moves while the result is still unknown.
+struct Node {
+    enum State : uint8_t { unexpanded, expanding, expanded };
+
+    std::atomic<uint32_t> visits {0};
+    std::atomic<uint32_t> value {0};
+    std::atomic<State> state {unexpanded};
+    uint8_t move {PASS};
+    uint8_t child_count {0};
+    uint32_t first_child {0};
+};
+
+/// Parallel UCT search on one size-specialised board.
+template<size_t N>
+class MonteCarloSearch
+{
+public:
+    using Geometry = BoardGeometry<N>;
+    using Bits = typename Geometry::Bits;
+
+    MonteCarloSearch(const Bits own, const Bits opp, const double exploration) :
+        root_own(own),
+        root_opp(opp),
+        exploration(exploration),
+        nodes(std::make_unique<Node[]>(NODE_CAPACITY))
+    {
+        expand(nodes[0], own, opp);
+    }
+
+    /// Run playouts until the deadline or the playout limit, or until stopped.
+    /// Returns the number of playouts this thread ran.
+    uint64_t run(
+        FastRandom random,
+        const std::optional<Clock::time_point> deadline,
+        const uint64_t max_playouts,
+        std::atomic<bool>& stop_signal
+    )
+    {
+        uint64_t count = 0;
+        while (!stop_signal.load(std::memory_order_relaxed)) {
+            if (max_playouts > 0 && total_playouts.fetch_add(1) >= max_playouts) {
+                break;
+            }
+            iterate(random);
+            ++count;
+            if (deadline && count % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= *deadline) {
+                stop_signal.store(true, std::memory_order_relaxed);
+            }
+        }
+        return count;
+    }
+
+    /// Most visited root move and its win rate.
+    [[nodiscard]] MctsResult result() const
+    {
+        MctsResult result;
+        const Node& root = nodes[0];
+        uint32_t most_visits = 0;
+        for (uint32_t i = 0; i < root.child_count; ++i) {
+            const Node& child = nodes[root.first_child + i];
+            const uint32_t visits = child.visits.load(std::memory_order_relaxed);
+            if (child.move != PASS && (!result.best_move || visits > most_visits)) {
+                most_visits = visits;
+                result.best_move = Geometry::INDEX_SQUARES[child.move];
+                result.win_rate = mean_value(child);
+            }
+        }
+        return result;
+    }
+
+private:
+    /// One selection, expansion, playout and backpropagation round.
+    void iterate(FastRandom& random)
+    {
+        std::array<Node*, Geometry::SQUARES * 2 + 2> path {};
+        size_t length = 0;
+        Bits own = root_own;
+        Bits opp = root_opp;
+        Node* node = &nodes[0];
+        node->visits.fetch_add(1, std::memory_order_relaxed);
+        path[length++] = node;
+        while (true) {
+            auto state = node->state.load(std::memory_order_acquire);
+            // Grow the tree by one level once a leaf has been visited before
+            if (state == Node::unexpanded && node->visits.load(std::memory_order_relaxed) > 1) {
+                expand(*node, own, opp);
+                state = node->state.load(std::memory_order_acquire);
+            }
+            if (state != Node::expanded || node->child_count == 0) {
+                break;
+            }
+            node = &select(*node);
+            node->visits.fetch_add(1, std::memory_order_relaxed);
+            path[length++] = node;
+            if (node->move != PASS) {
+                const Bits flipped = Geometry::flips(own, opp, node->move);
+                own |= flipped | square_bit<Bits>(node->move);
+                opp &= ~flipped;
+            }
+            std::swap(own, opp);
+        }
+        // Outcome for the side to move at the leaf, alternating on the way back up
+        uint32_t outcome = playout(own, opp, random);
+        for (size_t i = length; i-- > 0;) {
+            path[i]->value.fetch_add(WIN - outcome, std::memory_order_relaxed);
+            outcome = WIN - outcome;
+        }
+    }
+
+    /// Child with the highest upper confidence bound (UCT).
+    Node& select(const Node& parent)
+    {
+        const uint32_t parent_visits = parent.visits.load(std::memory_order_relaxed);
+        const double log_visits = std::log(static_cast<double>(std::max(parent_visits, 1U)));
+        Node* best = nullptr;
+        double best_score = -std::numeric_limits<double>::infinity();
+        for (uint32_t i = 0; i < parent.child_count; ++i) {
+            Node& child = nodes[parent.first_child + i];
+            const uint32_t visits = child.visits.load(std::memory_order_relaxed);
+            if (visits == 0) {
+                return child;
+            }
+            const double score = mean_value(child) + exploration * std::sqrt(log_visits / visits);
+            if (score > best_score) {
+                best_score = score;
+                best = &child;
+            }
+        }
+        return *best;
+    }
+
+    /// Average playout outcome through the node in range 0..1.
+    static double mean_value(const Node& node)
+    {
+        const uint32_t visits = node.visits.load(std::memory_order_relaxed);
+        if (visits == 0) {
+            return 0.0;
+        }
+        return node.value.load(std::memory_order_relaxed) / (static_cast<double>(WIN) * visits);
+    }
+
+    /// Add a child for each legal move. Only one thread expands a node, others treat it as a leaf.
+    void expand(Node& node, const Bits own, const Bits opp)
+    {
+        auto expected = Node::unexpanded;
+        if (!node.state.compare_exchange_strong(expected, Node::expanding)) {
+            return;
+        }
+        Bits legal = Geometry::legal_moves(own, opp);
+        uint32_t children = static_cast<uint32_t>(count(legal));
+        if (children == 0 && any(Geometry::legal_moves(opp, own))) {
+            // Passing is the only move
+            children = 1;
+        }
+        if (children > 0) {
+            if (next_free.load(std::memory_order_relaxed) + children > NODE_CAPACITY) {
+                node.state.store(Node::unexpanded, std::memory_order_release);
+                return;
+            }
+            const uint32_t first = next_free.fetch_add(children, std::memory_order_relaxed);
+            if (first + children > NODE_CAPACITY) {
+                // Tree is full, keep this node as a leaf
+                node.state.store(Node::unexpanded, std::memory_order_release);
+                return;
+            }
+            for (uint32_t i = 0; i < children; ++i) {
+                nodes[first + i].move = any(legal) ? static_cast<uint8_t>(pop_lowest(legal)) : PASS;
+            }
+            node.first_child = first;
+            node.child_count = static_cast<uint8_t>(children);
+        }
+        node.state.store(Node::expanded, std::memory_order_release);
+    }
+
+    /// Play random moves until the game ends.
+    /// Returns the outcome for the side to move at the start of the playout.
+    static uint32_t playout(Bits own, Bits opp, FastRandom& random)
+    {
+        bool swapped = false;
+        bool passed = false;
+        while (true) {
+            Bits legal = Geometry::legal_moves(own, opp);
+            if (any(legal)) {
+                passed = false;
+                for (uint64_t skip = random.below(count(legal)); skip > 0; --skip) {
+                    pop_lowest(legal);
+                }
+                const size_t index = lowest_index(legal);
+                const Bits flipped = Geometry::flips(own, opp, index);
+                own |= flipped | square_bit<Bits>(index);
+                opp &= ~flipped;
+            } else if (passed) {
+                break;
+            } else {
+                passed = true;
+            }
+            std::swap(own, opp);
+            swapped = !swapped;
+        }
+        if (swapped) {
+            std::swap(own, opp);
+        }
+        const size_t own_count = count(own);
+        const size_t opp_count = count(opp);
+        return own_count > opp_count ? WIN : own_count == opp_count ? DRAW : 0;
+    }
+
+    const Bits root_own;
+    const Bits root_opp;
+    const double exploration;
+    std::unique_ptr<Node[]> nodes;
+    std::atomic<uint32_t> next_free {1};
+    std::atomic<uint64_t> total_playouts {0};
+};
+}  // namespace
+
+/// Search for the best move with Monte Carlo tree search.
+///
+/// Each round descends the tree by the upper confidence bound (UCT), expands the leaf
+/// and scores it with a random playout to the end of the game.
+/// Needs no evaluation function, which makes it useful for the larger boards.
+/// All threads work on one shared tree with virtual loss, each with its own random generator.
+/// The most visited move is returned.
+MctsResult monte_carlo_search(const Board& board, const Disk disk, const MctsLimits& limits)
+{
+    if (!limits.time && limits.playouts == 0) {
+        throw std::invalid_argument("Monte Carlo tree search needs a time or playout limit");
+    }
+    const auto start = Clock::now();
+    std::optional<Clock::time_point> deadline;
+    if (limits.time) {
+        deadline = start + *limits.time;
+    }
+    const size_t threads = std::max<size_t>(limits.threads, 1);
+    MctsResult result = board.visit([&](const auto& sized) {
+        constexpr size_t N = std::remove_cvref_t<decltype(sized)>::SIZE;
+        MonteCarloSearch<N> search(
+            sized.disks(disk), sized.disks(opponent(disk)), limits.exploration
+        );
+        std::atomic<bool> stop_signal {false};
+        std::vector<uint64_t> playouts(threads);
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(threads);
+            uint64_t seed = limits.seed;
+            for (size_t thread = 0; thread < threads; ++thread) {
+                workers.emplace_back([&, thread, random = FastRandom(splitmix64(seed))] {
+                    playouts[thread] = search.run(random, deadline, limits.playouts, stop_signal);
+                });
+            }
+        }
+        MctsResult found = search.result();
+        for (const uint64_t count : playouts) {
+            found.playouts += count;
+        }
+        return found;
+    });
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    result.threads = threads;
+    return result;
+}
+
+}  // namespace othello
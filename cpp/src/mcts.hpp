@@ -0,0 +1,54 @@
+//==========================================================
+// Monte Carlo tree search header
+// Playout based computer player search
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+
+#include <algorithm>  // std::max
+#include <chrono>
+#include <cstdint>  // uint64_t
+#include <optional>
+
+namespace othello
+{
+/// Limits for one Monte Carlo tree search. At least one of time and playouts must be set.
+struct MctsLimits {
+    /// Wall-clock budget
+    std::optional<std::chrono::milliseconds> time;
+    /// Maximum number of playouts over all threads, zero for no limit
+    uint64_t playouts {0};
+    /// Number of search threads
+    size_t threads {1};
+    /// UCT exploration constant, higher values try less visited moves more often
+    double exploration {DEFAULT_EXPLORATION};
+    /// Seed for the playout random generators
+    uint64_t seed {0};
+};
+
+/// Result of a Monte Carlo tree search.
+struct MctsResult {
+    /// Most visited move, or empty if the side to move has no legal moves
+    std::optional<Square> best_move;
+    /// Share of won playouts through the best move, draws count as half
+    double win_rate {0.0};
+    /// Number of playouts over all threads
+    uint64_t playouts {0};
+    /// Wall-clock time used
+    std::chrono::milliseconds elapsed {0};
+    /// Number of search threads used
+    size_t threads {1};
+
+    /// Search speed in playouts per second.
+    [[nodiscard]] uint64_t playouts_per_second() const
+    {
+        return playouts * 1000 / static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 1));
+    }
+};
+
+MctsResult monte_carlo_search(const Board& board, Disk disk, const MctsLimits& limits);
+
+}  // namespace othello
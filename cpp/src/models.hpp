@@ -9,9 +9,11 @@
 
 #include "colorprint.hpp"
 
-#include <compare>  // three-way comparison
-#include <string>   // string
-#include <utility>  // move
+#include <array>
+#include <compare>           // three-way comparison
+#include <initializer_list>  // initializer_list
+#include <string>            // string
+#include <type_traits>       // is_trivially_copyable
 #include <vector>
 
 namespace othello
@@ -43,10 +45,28 @@ struct Step {
     int y;
 };
 
+constexpr int UP = 1;
+constexpr int DOWN = -1;
+constexpr int LEFT = -1;
+constexpr int RIGHT = 1;
+constexpr int STILL = 0;
+
+/// All possible step directions for a square on the board.
+static constexpr std::array<Step, 8> STEP_DIRECTIONS {{
+    {DOWN, LEFT},
+    {DOWN, RIGHT},
+    {DOWN, STILL},
+    {STILL, LEFT},
+    {STILL, RIGHT},
+    {UP, LEFT},
+    {UP, RIGHT},
+    {UP, STILL},
+}};
+
 /// Represents one square location on the board.
 struct Square {
-    Square() : x(0), y(0) {}
-    Square(const int x, const int y) : x(x), y(y) {}
+    constexpr Square() : x(0), y(0) {}
+    constexpr Square(const int x, const int y) : x(x), y(y) {}
 
     /// Get the index of this square on the board.
     [[nodiscard]] constexpr size_t board_index(const size_t board_size) const
@@ -89,6 +109,7 @@ struct Square {
 /// The `step` field determines the direction on the board,
 /// and `count` describes how many consecutive squares in that direction there are.
 struct Direction {
+    constexpr Direction() : step(STILL, STILL), count(0) {}
     constexpr Direction(const Step step, const size_t count) : step(step), count(count) {}
 
     // Ordered by step, then count. Also provides the implicitly defaulted `==`.
@@ -100,19 +121,71 @@ struct Direction {
     size_t count;
 };
 
+/// Fixed-capacity list of the directions one move flips disks in.
+///
+/// A move can flip along at most eight directions,
+/// so the list is stored inline without heap allocation.
+class DirectionList
+{
+public:
+    constexpr DirectionList() = default;
+    constexpr DirectionList(const std::initializer_list<Direction> directions)
+    {
+        for (const auto& direction : directions) {
+            push_back(direction);
+        }
+    }
+
+    constexpr void push_back(const Direction& direction)
+    {
+        items[length++] = direction;
+    }
+    constexpr void emplace_back(const Step step, const size_t count)
+    {
+        items[length++] = Direction(step, count);
+    }
+
+    [[nodiscard]] constexpr const Direction* begin() const
+    {
+        return items.data();
+    }
+    [[nodiscard]] constexpr const Direction* end() const
+    {
+        return items.data() + length;
+    }
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return length;
+    }
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return length == 0;
+    }
+    [[nodiscard]] constexpr const Direction& operator[](const size_t index) const
+    {
+        return items[index];
+    }
+
+private:
+    std::array<Direction, STEP_DIRECTIONS.size()> items {};
+    size_t length {0};
+};
+
 /// Represents one possible disk placement for the given disk colour.
+///
+/// Trivially copyable so move lists can be copied and stored without heap allocations.
 struct Move {
     Move() : square(0, 0), disk(Disk::empty), value(0) {}
     Move(
         const Square square,
         const Disk disk,
         const size_t value,
-        std::vector<Direction> directions
+        const DirectionList& directions
     ) :
         square(square),
         disk(disk),
         value(value),
-        directions(std::move(directions))
+        directions(directions)
     {}
 
     [[nodiscard]] std::string log_entry() const;
@@ -138,9 +211,11 @@ struct Move {
     Square square;
     Disk disk;
     size_t value;
-    std::vector<Direction> directions;
+    DirectionList directions;
 };
 
+static_assert(std::is_trivially_copyable_v<Move>);
+
 /// Returns a single character identifier string for the given disk.
 [[nodiscard]] std::string board_char(Disk disk);
 
@@ -0,0 +1,132 @@
+//==========================================================
+// Opening book source
+// Precomputed moves for the opening read from a memory-mapped file
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "opening_book.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>  // std::ranges::sort, std::ranges::lower_bound, std::ranges::unique
+#include <array>
+#include <cstring>  // std::memcpy
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>  // std::remove_cvref_t
+
+namespace othello
+{
+namespace
+{
+constexpr std::array<char, 8> BOOK_MAGIC {'O', 'T', 'H', 'B', 'O', 'O', 'K', '\0'};
+constexpr uint32_t BOOK_VERSION = 1;
+
+/// File header in front of the sorted records.
+///
+/// Header and records are stored in the byte order of the machine that wrote the book.
+/// A book from a machine with the other byte order fails the version check.
+struct BookHeader {
+    std::array<char, 8> magic {BOOK_MAGIC};
+    uint32_t version {BOOK_VERSION};
+    uint32_t board_size {0};
+    uint64_t count {0};
+};
+
+static_assert(sizeof(BookHeader) % alignof(BookRecord) == 0, "records must stay aligned");
+}  // namespace
+
+/// Map the book file into memory and check its header.
+OpeningBook::OpeningBook(const std::filesystem::path& path) : file(path)
+{
+    BookHeader header;
+    if (file.size() < sizeof(BookHeader)) {
+        throw std::runtime_error(fmt::format("Invalid opening book: {}", path.string()));
+    }
+    std::memcpy(&header, file.data(), sizeof(BookHeader));
+    // Count checked against the space left first, so a corrupt count cannot overflow the size
+    const size_t record_space = file.size() - sizeof(BookHeader);
+    if (header.magic != BOOK_MAGIC || header.version != BOOK_VERSION
+        || header.board_size < MIN_BOARD_SIZE || header.board_size > MAX_BOARD_SIZE
+        || header.count > record_space / sizeof(BookRecord)
+        || record_space != header.count * sizeof(BookRecord)) {
+        throw std::runtime_error(fmt::format("Invalid opening book: {}", path.string()));
+    }
+    size_of_board = header.board_size;
+    records = {
+        reinterpret_cast<const BookRecord*>(file.data() + sizeof(BookHeader)),
+        static_cast<size_t>(header.count)
+    };
+}
+
+/// Book move for the given position, or nothing if the position is not in the book.
+std::optional<BookMove> OpeningBook::lookup(const Board& board, const Disk disk) const
+{
+    const size_t size = board.visit([](const auto& sized) {
+        return std::remove_cvref_t<decltype(sized)>::SIZE;
+    });
+    if (size != size_of_board) {
+        return std::nullopt;
+    }
+    const auto [key, symmetry] = canonical_position(board, disk);
+    const auto record = find(key);
+    if (!record) {
+        return std::nullopt;
+    }
+    return BookMove {
+        from_canonical_move(board, record->move, symmetry), record->score, record->depth
+    };
+}
+
+/// Binary search for the record with the given canonical key.
+std::optional<BookRecord> OpeningBook::find(const uint64_t key) const
+{
+    const auto found = std::ranges::lower_bound(records, key, {}, &BookRecord::key);
+    if (found == records.end() || found->key != key) {
+        return std::nullopt;
+    }
+    return *found;
+}
+
+/// Number of positions in the book.
+size_t OpeningBook::size() const
+{
+    return records.size();
+}
+
+/// Board size the book was built for.
+size_t OpeningBook::board_size() const
+{
+    return size_of_board;
+}
+
+/// Write a book file from the given records.
+/// Records are sorted, and for duplicate positions the deepest search is kept.
+void OpeningBook::write(
+    const std::filesystem::path& path,
+    const size_t board_size,
+    std::vector<BookRecord> records
+)
+{
+    std::ranges::sort(records, [](const BookRecord& a, const BookRecord& b) {
+        return a.key < b.key || (a.key == b.key && a.depth > b.depth);
+    });
+    const auto duplicates = std::ranges::unique(records, {}, &BookRecord::key);
+    records.erase(duplicates.begin(), duplicates.end());
+
+    BookHeader header;
+    header.board_size = static_cast<uint32_t>(board_size);
+    header.count = records.size();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(
+        reinterpret_cast<const char*>(records.data()),
+        static_cast<std::streamsize>(records.size() * sizeof(BookRecord))
+    );
+    if (!file) {
+        throw std::runtime_error(fmt::format("Failed to write opening book: {}", path.string()));
+    }
+}
+
+}  // namespace othello
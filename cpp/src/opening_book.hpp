@@ -0,0 +1,75 @@
+//==========================================================
+// Opening book header
+// Precomputed moves for the opening read from a memory-mapped file
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+#include "mapped_file.hpp"
+#include "symmetry.hpp"
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace othello
+{
+/// One book position as stored in the file. Records are sorted by key.
+struct BookRecord {
+    /// Canonical hash of the position and the side to move
+    uint64_t key {0};
+    /// Score of the best move from the point of view of the side to move
+    int16_t score {0};
+    /// Best move as a board index in the canonical orientation
+    uint8_t move {0};
+    /// Search depth the score comes from
+    uint8_t depth {0};
+    /// Keeps records aligned to 8 bytes in the file
+    uint32_t padding {0};
+
+    bool operator==(const BookRecord& other) const = default;
+};
+
+static_assert(sizeof(BookRecord) == 16, "book records are read directly from the file");
+
+/// Book move for the current position.
+struct BookMove {
+    Square square;
+    int score {0};
+    int depth {0};
+};
+
+/// Read-only opening book mapped into memory.
+///
+/// The file is a small header followed by records sorted by key,
+/// so lookups are a binary search directly on the mapped pages.
+/// Records are read in place, so they are in the native byte order
+/// and book files are not portable between little-endian and big-endian machines.
+class OpeningBook
+{
+public:
+    explicit OpeningBook(const std::filesystem::path& path);
+
+    [[nodiscard]] std::optional<BookMove> lookup(const Board& board, Disk disk) const;
+    [[nodiscard]] std::optional<BookRecord> find(uint64_t key) const;
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t board_size() const;
+
+    static void write(
+        const std::filesystem::path& path,
+        size_t board_size,
+        std::vector<BookRecord> records
+    );
+
+private:
+    MappedFile file;
+    std::span<const BookRecord> records;
+    size_t size_of_board {0};
+};
+
+}  // namespace othello
@@ -20,10 +20,11 @@ namespace othello
 
 /// Initialize Othello game.
 Othello::Othello(const Settings settings) :
-    board(Board(settings.board_size)),
+    game(settings.board_size),
     settings(settings),
     player_black(Player::black(settings.to_player_settings())),
-    player_white(Player::white(settings.to_player_settings()))
+    player_white(Player::white(settings.to_player_settings())),
+    game_record {settings.board_size, 0, {}}
 {}
 
 /// Play one full game of Othello.
@@ -47,11 +48,11 @@ void Othello::init_game()
 {
     // Re-use existing objects instead of initializing new ones
     if (games_played > 0) {
-        board = Board(this->settings.board_size);
+        game = Game(this->settings.board_size);
         player_black.reset();
         player_white.reset();
         rounds_played = 0;
-        game_log.clear();
+        game_record.turns.clear();
     }
     if (this->settings.autoplay_mode) {
         // Computer plays both
@@ -76,12 +77,13 @@ void Othello::init_game()
 /// Keep making moves until both players can't make a move any more.
 void Othello::game_loop()
 {
-    while (board.can_play() && (player_black.can_play || player_white.can_play)) {
+    while (game.board().can_play() && (player_black.can_play || player_white.can_play)) {
         ++rounds_played;
         print_round_header();
         for (Player* player : {&player_black, &player_white}) {
-            if (auto result = player->play_one_move(board); result.has_value()) {
-                game_log.push_back(fmt::format("{};{}", result.value(), board.log_entry()));
+            const Turn turn = player->play_one_move(game);
+            if (this->settings.show_log) {
+                game_record.add(turn);
             }
             if (!this->settings.check_mode) {
                 fmt::print("--------------------------------\n");
@@ -96,12 +98,13 @@ void Othello::game_loop()
 std::string Othello::format_game_log() const
 {
     std::string formatted_log;
-    size_t index = 1;
-    for (const auto& line : game_log) {
-        formatted_log += fmt::format("{:02}: {}", index++, line);
-        if (index <= game_log.size()) {
+    GameLogReplay replay(game_record);
+    size_t index = 0;
+    while (const auto line = replay.next()) {
+        if (index > 0) {
             formatted_log += "\n";
         }
+        formatted_log += fmt::format("{:02}: {}", ++index, *line);
     }
     return formatted_log;
 }
@@ -124,15 +127,28 @@ void Othello::print_game_end_footer() const
 }
 
 /// Print game log which shows all moves made and the game board state after each move.
+///
+/// The log is rebuilt from the recorded moves one line at a time,
+/// and the hash is updated with each line instead of hashing the whole formatted log.
 void Othello::print_log() const
 {
-    const auto formatted_log = format_game_log();
     if (!this->settings.check_mode) {
         print_yellow_bold("Game log:\n");
-        print(formatted_log);
     }
-    const auto hex_hash = calculate_sha256(formatted_log);
-    print(hex_hash);
+    Sha256 hash;
+    GameLogReplay replay(game_record);
+    size_t index = 0;
+    while (const auto line = replay.next()) {
+        if (index > 0) {
+            hash.update("\n");
+        }
+        const auto numbered_line = fmt::format("{:02}: {}", ++index, *line);
+        hash.update(numbered_line);
+        if (!this->settings.check_mode) {
+            print(numbered_line);
+        }
+    }
+    print(hash.hex_digest());
 }
 
 /// Print ending status and winner info.
@@ -142,7 +158,7 @@ void Othello::print_result() const
     print_status();
     fmt::print("\n");
 
-    if (const Disk winner = board.result(); winner == Disk::empty) {
+    if (const Disk winner = game.result().winner(); winner == Disk::empty) {
         fmt::print("The game ended in a tie...\n\n");
     } else {
         fmt::print("The winner is {}!\n\n", disk_string(winner));
@@ -155,7 +171,7 @@ void Othello::print_status() const
     print(player_black);
     print(player_white);
     print("");
-    print(board);
+    print(game.board());
 }
 
 /// Ask a question with two options, and return bool from user answer.
@@ -7,7 +7,10 @@
 //==========================================================
 
 #pragma once
+#include "game.hpp"
+#include "game_record.hpp"
 #include "player.hpp"
+
 #include <string_view>
 
 namespace othello
@@ -38,13 +41,16 @@ private:
         std::string_view no = "n"
     );
 
-    Board board;
+    Game game;
     Settings settings;
     Player player_black;
     Player player_white;
-    std::vector<std::string> game_log;
+    /// Moves of the current game, replayed into the log when it is printed.
+    GameRecord game_record;
     size_t games_played {0};
     size_t rounds_played {0};
+
+    friend class OthelloBenchmark;
 };
 
 }  // namespace othello
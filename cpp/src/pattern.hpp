@@ -0,0 +1,242 @@
+//==========================================================
+// Pattern header
+// Board patterns for the pattern-based evaluation
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "sized_board.hpp"
+
+#include <algorithm>  // std::min
+#include <array>
+#include <cstdint>  // uint8_t, uint32_t
+#include <utility>  // std::pair
+
+namespace othello
+{
+/// Pattern shapes. All symmetric instances of a shape share one weight table.
+enum class PatternShape : uint8_t {
+    /// Full edge row
+    edge,
+    /// Main diagonal from corner to corner
+    diagonal,
+    /// 2 x 5 block along an edge from a corner
+    corner_block,
+    /// 3 x 3 block in a corner
+    corner_square,
+};
+
+constexpr size_t PATTERN_SHAPES = 4;
+constexpr size_t MAX_PATTERN_SQUARES = 10;
+
+/// Powers of three for the base-3 pattern indices.
+constexpr std::array<uint32_t, MAX_PATTERN_SQUARES + 1> POWERS_OF_THREE = [] {
+    std::array<uint32_t, MAX_PATTERN_SQUARES + 1> powers {};
+    uint32_t power = 1;
+    for (auto& value : powers) {
+        value = power;
+        power *= 3;
+    }
+    return powers;
+}();
+
+/// Pattern layout for an N x N board.
+///
+/// Each pattern instance is a list of squares. The squares of an instance are listed
+/// in the same order as in the canonical instance at the top left corner,
+/// so symmetric instances give the same index for the same disk configuration.
+/// A pattern index has one base-3 digit per square: 0 empty, 1 black, 2 white.
+template<size_t N>
+struct PatternGeometry {
+    static constexpr size_t SQUARES = N * N;
+    /// Length of the long side of the corner block, shorter on the 4 x 4 board
+    static constexpr size_t BLOCK = std::min<size_t>(N, 5);
+    /// Number of squares in each shape
+    static constexpr std::array<size_t, PATTERN_SHAPES> LENGTHS {N, N, 2 * BLOCK, 9};
+    /// 4 edges, 2 diagonals, 8 corner blocks and 4 corner squares
+    static constexpr size_t COUNT = 18;
+
+    struct Pattern {
+        PatternShape shape {PatternShape::edge};
+        std::array<uint8_t, MAX_PATTERN_SQUARES> squares {};
+    };
+
+    /// Pattern that a square belongs to and the value of its digit in the pattern index.
+    struct Member {
+        uint8_t pattern {0};
+        uint32_t power {0};
+    };
+
+    struct Members {
+        size_t size {0};
+        std::array<Member, 16> members {};
+    };
+
+    /// Coordinates of the i-th square of the canonical instance of a shape.
+    static constexpr std::pair<size_t, size_t> canonical(const PatternShape shape, const size_t i)
+    {
+        switch (shape) {
+            case PatternShape::edge:
+                return {i, 0};
+            case PatternShape::diagonal:
+                return {i, i};
+            case PatternShape::corner_block:
+                return {i % BLOCK, i / BLOCK};
+            default:
+                return {i % 3, i / 3};
+        }
+    }
+
+    static constexpr std::array<Pattern, COUNT> PATTERNS = [] {
+        struct Instances {
+            PatternShape shape;
+            std::array<unsigned, 8> symmetries;
+            size_t size;
+        };
+        constexpr std::array<Instances, PATTERN_SHAPES> instances {{
+            {PatternShape::edge, {0, 4, 1, 3}, 4},
+            {PatternShape::diagonal, {0, 2}, 2},
+            {PatternShape::corner_block, {0, 1, 2, 3, 4, 5, 6, 7}, 8},
+            {PatternShape::corner_square, {0, 2, 4, 6}, 4},
+        }};
+        std::array<Pattern, COUNT> patterns {};
+        size_t next = 0;
+        for (const auto& [shape, symmetries, size] : instances) {
+            for (size_t s = 0; s < size; ++s) {
+                Pattern& pattern = patterns[next++];
+                pattern.shape = shape;
+                for (size_t i = 0; i < LENGTHS[static_cast<size_t>(shape)]; ++i) {
+                    const auto [x, y] = canonical(shape, i);
+                    pattern.squares[i] = static_cast<uint8_t>(
+                        BoardGeometry<N>::transform(y * N + x, symmetries[s])
+                    );
+                }
+            }
+        }
+        return patterns;
+    }();
+
+    /// Patterns containing each square, used for the incremental index updates.
+    static constexpr std::array<Members, SQUARES> SQUARE_PATTERNS = [] {
+        std::array<Members, SQUARES> squares {};
+        for (size_t p = 0; p < COUNT; ++p) {
+            const Pattern& pattern = PATTERNS[p];
+            for (size_t i = 0; i < LENGTHS[static_cast<size_t>(pattern.shape)]; ++i) {
+                Members& members = squares[pattern.squares[i]];
+                members.members[members.size++]
+                    = {static_cast<uint8_t>(p), POWERS_OF_THREE[i]};
+            }
+        }
+        return squares;
+    }();
+};
+
+/// Pattern indices of a position, kept up to date move by move.
+///
+/// Making a move only touches the patterns that contain the placed or flipped squares,
+/// so the evaluation never has to scan the whole board.
+template<size_t N>
+class PatternFeatures
+{
+public:
+    using Geometry = PatternGeometry<N>;
+    using Bits = BitsFor<N>;
+    using Indices = std::array<uint32_t, Geometry::COUNT>;
+
+    constexpr PatternFeatures() = default;
+
+    /// Compute all pattern indices from scratch.
+    explicit constexpr PatternFeatures(const SizedBoard<N>& board)
+    {
+        for (size_t p = 0; p < Geometry::COUNT; ++p) {
+            const auto& pattern = Geometry::PATTERNS[p];
+            const size_t length = Geometry::LENGTHS[static_cast<size_t>(pattern.shape)];
+            for (size_t i = 0; i < length; ++i) {
+                indices[p] += digit(board.get(pattern.squares[i])) * POWERS_OF_THREE[i];
+            }
+        }
+    }
+
+    bool operator==(const PatternFeatures& other) const = default;
+
+    /// Update the indices for a move made on the board.
+    constexpr void apply(const MoveUndo<Bits>& undo)
+    {
+        update(undo, 1);
+    }
+
+    /// Update the indices for a move taken back on the board.
+    constexpr void revert(const MoveUndo<Bits>& undo)
+    {
+        update(undo, -1);
+    }
+
+    [[nodiscard]] constexpr const Indices& values() const
+    {
+        return indices;
+    }
+
+private:
+    static constexpr uint32_t digit(const Disk disk)
+    {
+        return disk == Disk::black ? 1 : disk == Disk::white ? 2 : 0;
+    }
+
+    constexpr void update(const MoveUndo<Bits>& undo, const int32_t sign)
+    {
+        add(undo.index, sign * static_cast<int32_t>(digit(undo.disk)));
+        // Flipping changes the digit from the opponent colour to the placed colour
+        const int32_t flip = undo.disk == Disk::black ? -sign : sign;
+        Bits remaining = undo.flipped;
+        while (any(remaining)) {
+            add(pop_lowest(remaining), flip);
+        }
+    }
+
+    constexpr void add(const size_t square, const int32_t delta)
+    {
+        const auto& [size, members] = Geometry::SQUARE_PATTERNS[square];
+        for (size_t i = 0; i < size; ++i) {
+            const auto& [pattern, power] = members[i];
+            indices[pattern] += static_cast<uint32_t>(delta * static_cast<int32_t>(power));
+        }
+    }
+
+    Indices indices {};
+};
+
+/// Applies a move to the pattern indices for the lifetime of the guard.
+///
+/// Used together with `ScopedMove` to keep the indices in step with the board:
+/// ```
+/// ScopedMove guard(board, disk, index);
+/// ScopedPatterns patterns_guard(patterns, guard.record());
+/// ```
+template<size_t N>
+class ScopedPatterns
+{
+public:
+    using Undo = MoveUndo<BitsFor<N>>;
+
+    ScopedPatterns(PatternFeatures<N>& patterns, const Undo& undo) : patterns(patterns), undo(undo)
+    {
+        patterns.apply(undo);
+    }
+
+    ~ScopedPatterns()
+    {
+        patterns.revert(undo);
+    }
+
+    ScopedPatterns(const ScopedPatterns&) = delete;
+    ScopedPatterns& operator=(const ScopedPatterns&) = delete;
+    ScopedPatterns(ScopedPatterns&&) = delete;
+    ScopedPatterns& operator=(ScopedPatterns&&) = delete;
+
+private:
+    PatternFeatures<N>& patterns;
+    const Undo& undo;
+};
+
+}  // namespace othello
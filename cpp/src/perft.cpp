@@ -0,0 +1,63 @@
+//==========================================================
+// Perft source
+// Move generator node counting
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "perft.hpp"
+
+#include <fmt/format.h>
+
+#include <stdexcept>
+
+namespace othello
+{
+/// Count the leaf positions of the game tree `depth` plies from the given board.
+///
+/// Moves are generated and played through the same `Board` interface the game uses.
+/// Like in `Othello::game_loop`, a side without moves passes and the pass takes one ply.
+/// A finished game is a leaf even if it ends before the full depth.
+/// The board is restored before returning.
+uint64_t perft(Board& board, const int depth)
+{
+    if (depth <= 0) {
+        return 1;
+    }
+    const Disk disk = board.side_to_move();
+    const auto moves = board.possible_moves(disk);
+    if (moves.empty()) {
+        if (board.possible_moves(opponent(disk)).empty()) {
+            return 1;
+        }
+        board.pass();
+        const uint64_t nodes = perft(board, depth - 1);
+        board.pass();
+        return nodes;
+    }
+    uint64_t nodes = 0;
+    for (const auto& move : moves) {
+        const auto undo = board.make_move(move);
+        nodes += perft(board, depth - 1);
+        board.unmake_move(undo);
+    }
+    return nodes;
+}
+
+/// Count the leaf positions `depth` plies from the start position and time it.
+PerftResult perft(const size_t board_size, const int depth)
+{
+    if (depth < 0) {
+        throw std::invalid_argument(fmt::format("Unsupported perft depth: {}", depth));
+    }
+    Board board(board_size);
+    const auto start = std::chrono::steady_clock::now();
+    PerftResult result;
+    result.nodes = perft(board, depth);
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start
+    );
+    return result;
+}
+
+}  // namespace othello
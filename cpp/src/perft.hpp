@@ -0,0 +1,34 @@
+//==========================================================
+// Perft header
+// Move generator node counting
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+
+#include <algorithm>  // std::max
+#include <chrono>
+#include <cstdint>  // uint64_t
+
+namespace othello
+{
+/// Result of a perft run.
+struct PerftResult {
+    /// Number of leaf positions
+    uint64_t nodes {0};
+    /// Wall-clock time used
+    std::chrono::milliseconds elapsed {0};
+
+    /// Move generation speed in leaf nodes per second.
+    [[nodiscard]] uint64_t nodes_per_second() const
+    {
+        return nodes * 1000 / static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 1));
+    }
+};
+
+uint64_t perft(Board& board, int depth);
+PerftResult perft(size_t board_size, int depth);
+
+}  // namespace othello
@@ -9,42 +9,46 @@
 
 #include "colorprint.hpp"
 
+#include <algorithm>  // std::ranges::find_if
 #include <chrono>
+#include <iostream>  // std::cin, std::cout
 #include <optional>  // std::optional
 #include <ranges>
-#include <stdexcept>  // exceptions
-#include <thread>     // sleep_for
+#include <thread>   // sleep_for
+#include <variant>  // std::get_if
 
 namespace othello
 {
 /// Play one round as this player.
-std::optional<std::string> Player::play_one_move(Board& board)
+Turn Player::play_one_move(Game& game)
 {
     if (!this->settings.check_mode) {
         print("Turn: " + disk_string(disk));
     }
-    const auto moves = board.possible_moves(disk);
+    const auto moves = game.legal_moves();
     if (moves.empty()) {
         can_play = false;
+        game.pass();
         if (!this->settings.check_mode) {
             print_yellow("  No moves available...\n");
         }
-        return std::nullopt;
+        return {disk, std::nullopt};
     }
     can_play = true;
     if (this->human() && this->settings.show_helpers && !this->settings.check_mode) {
-        board.print_possible_moves(moves);
+        game.board().print_possible_moves(moves);
     }
-    const auto chosen_move = human() ? get_human_move(moves) : get_computer_move(moves);
-    board.place_disk(chosen_move);
+    const auto chosen_move
+        = human() ? get_human_move(moves) : get_computer_move(game.board(), moves);
+    game.apply(chosen_move);
     if (!this->settings.check_mode) {
-        board.print_score();
+        game.board().print_score();
     }
     ++rounds_played;
     if (!this->settings.test_mode) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1000));
     }
-    return chosen_move.log_entry();
+    return {disk, chosen_move};
 }
 
 /// Reset player status for a new game.
@@ -52,6 +56,7 @@ void Player::reset()
 {
     this->can_play = true;
     this->rounds_played = 0;
+    this->computer_player.reset();
 }
 
 /// Returns true if player is controlled by a human player.
@@ -85,30 +90,55 @@ void Player::set_computer()
 }
 
 /// Return move chosen by computer.
-Move Player::get_computer_move(const std::vector<Move>& moves)
+Move Player::get_computer_move(const Board& board, const std::vector<Move>& moves)
 {
     if (!this->settings.check_mode) {
         print("  Computer plays...");
     }
-    Move chosen_move;
-    if (this->settings.test_mode) {
-        chosen_move = moves[0];
-    } else {
-        // Wait a bit and pick a random move
-        std::uniform_int_distribution rand_time(1000, 2000);
-        const auto sleep_duration = std::chrono::milliseconds(rand_time(this->random));
-        std::this_thread::sleep_for(sleep_duration);
-
-        std::uniform_int_distribution<size_t> random_item(0, moves.size() - 1);
-        // C++17 std::sample is even more convoluted here :(
-        chosen_move = moves[random_item(this->random)];
-    }
+    const auto [chosen_move, details] = computer_player.choose_move(board, moves);
     if (!this->settings.check_mode) {
+        print_move_details(board, details);
         fmt::print("  {} -> {}\n", chosen_move.square, chosen_move.value);
     }
     return chosen_move;
 }
 
+/// Print how the computer found its move.
+void Player::print_move_details(const Board& board, const MoveDetails& details) const
+{
+    if (const auto* tablebase_move = std::get_if<TablebaseMove>(&details)) {
+        fmt::print("  Tablebase move, final score {:+}\n", tablebase_move->score);
+    } else if (const auto* book_move = std::get_if<BookMove>(&details)) {
+        fmt::print("  Book move, score {} from depth {}\n", book_move->score, book_move->depth);
+    } else if (const auto* solve = std::get_if<SolveResult>(&details)) {
+        fmt::print(
+            "  Solved {} empty squares: {:+} disks, {} nodes in {} ms\n",
+            board.empty_count(),
+            solve->score,
+            solve->nodes,
+            solve->elapsed.count()
+        );
+    } else if (const auto* mcts = std::get_if<MctsResult>(&details)) {
+        fmt::print(
+            "  {} playouts in {} ms with {} threads, {} playouts/s, win rate {:.1f}%\n",
+            mcts->playouts,
+            mcts->elapsed.count(),
+            mcts->threads,
+            mcts->playouts_per_second(),
+            100.0 * mcts->win_rate
+        );
+    } else if (const auto* search = std::get_if<SearchResult>(&details)) {
+        fmt::print(
+            "  Depth {}, {} nodes in {} ms with {} threads, {} nodes/s\n",
+            search->depth,
+            search->nodes,
+            search->elapsed.count(),
+            search->threads,
+            search->nodes_per_second()
+        );
+    }
+}
+
 /// Return move chosen by a human player.
 Move Player::get_human_move(const std::vector<Move>& moves) const
 {
@@ -7,10 +7,13 @@
 
 #pragma once
 #include "board.hpp"
+#include "computer.hpp"
+#include "game.hpp"
 #include "settings.hpp"
 #include "utils.hpp"
 
-#include <random>
+#include <optional>
+#include <string>
 
 namespace othello
 {
@@ -39,7 +42,10 @@ class Player
 {
 public:
     /// Initialize new player for the given disk colour.
-    explicit Player(const Disk disk, const PlayerSettings settings) : disk(disk), settings(settings)
+    explicit Player(const Disk disk, const PlayerSettings settings) :
+        disk(disk),
+        settings(settings),
+        computer_player(disk, settings.search, settings.test_mode)
     {}
 
     /// Shorthand to initialize a new player for black disks.
@@ -54,7 +60,7 @@ public:
         return Player(Disk::white, settings);
     }
 
-    [[nodiscard]] std::optional<std::string> play_one_move(Board& board);
+    Turn play_one_move(Game& game);
     void reset();
     [[nodiscard]] bool human() const;
     [[nodiscard]] bool computer() const;
@@ -69,7 +75,8 @@ public:
     bool can_play {true};
 
 private:
-    [[nodiscard]] Move get_computer_move(const std::vector<Move>& moves);
+    [[nodiscard]] Move get_computer_move(const Board& board, const std::vector<Move>& moves);
+    void print_move_details(const Board& board, const MoveDetails& details) const;
     [[nodiscard]] Move get_human_move(const std::vector<Move>& moves) const;
     static Square get_square();
 
@@ -79,8 +86,7 @@ private:
     PlayerType player_type {PlayerType::Human};
     int rounds_played {0};
     PlayerSettings settings;
-
-    std::mt19937 random {std::mt19937 {std::random_device {}()}};
+    Computer computer_player;
 };
 
 }  // namespace othello
@@ -0,0 +1,336 @@
+//==========================================================
+// Search source
+// Game tree search for the computer player
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "search.hpp"
+
+#include "evaluation.hpp"
+
+#include <algorithm>  // std::clamp, std::min, std::max
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>       // std::jthread
+#include <type_traits>  // std::remove_cvref_t
+#include <vector>
+
+namespace othello
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// How many nodes to search between checks of the clock and the stop signal.
+constexpr uint64_t CLOCK_CHECK_INTERVAL = 1024;
+
+/// Negamax alpha-beta search with principal variation search on one size-specialised board.
+///
+/// Moves are made and taken back in place on a single board copy,
+/// so no allocations happen inside the search.
+/// The pattern indices for the evaluation follow every move incrementally.
+template<size_t N>
+class Searcher
+{
+public:
+    using Board = SizedBoard<N>;
+    using Bits = typename Board::Bits;
+
+    Searcher(
+        const Board& board,
+        TranspositionTable& table,
+        const std::optional<Clock::time_point> deadline,
+        const std::atomic<bool>& stop_signal
+    ) :
+        board(board),
+        table(table),
+        deadline(deadline),
+        stop_signal(stop_signal),
+        patterns(board)
+    {}
+
+    /// Search with increasing depth until the maximum depth or the deadline is reached.
+    ///
+    /// Each iteration starts from the best move of the previous one through the table.
+    /// An iteration interrupted by the deadline is discarded,
+    /// so the result always comes from the last completed iteration.
+    SearchResult iterative_deepening(
+        const Disk disk,
+        const int max_depth,
+        const int first_depth = 1
+    )
+    {
+        const auto start = Clock::now();
+        // Deeper than the number of empty squares gives the same result
+        const int empty = static_cast<int>(count(board.empty()));
+        const int depth_limit = std::max(std::min(max_depth, empty), 1);
+        SearchResult best;
+        for (int depth = std::min(first_depth, depth_limit); depth <= depth_limit; ++depth) {
+            const SearchResult result = search_root(disk, depth);
+            if (stopped) {
+                break;
+            }
+            best = result;
+            // Only the first iteration has to finish
+            can_stop = deadline.has_value();
+            if (!best.best_move) {
+                break;
+            }
+            if (deadline && Clock::now() + (Clock::now() - start) >= *deadline) {
+                // Next iteration would not finish in time
+                break;
+            }
+        }
+        best.nodes = nodes;
+        best.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+        return best;
+    }
+
+private:
+    /// Search the given depth and return the best move for the side to move.
+    SearchResult search_root(const Disk disk, const int depth)
+    {
+        if (board.side_to_move() != disk) {
+            board.pass();
+        }
+        SearchResult result;
+        result.depth = depth;
+        const Bits legal = board.legal_moves(disk);
+        if (!any(legal)) {
+            result.score = negamax(disk, depth, -INFINITE_SCORE, INFINITE_SCORE, false);
+            return result;
+        }
+        MoveList moves = ordered_moves(disk, legal, probe_move(), depth);
+        int alpha = -INFINITE_SCORE;
+        const int beta = INFINITE_SCORE;
+        size_t best = moves.indices[0];
+        for (size_t i = 0; i < moves.size; ++i) {
+            const size_t index = moves.indices[i];
+            const int score = search_move(disk, index, depth, alpha, beta, i == 0);
+            if (stopped) {
+                return result;
+            }
+            if (score > alpha) {
+                alpha = score;
+                best = index;
+            }
+        }
+        store(depth, alpha, Bound::exact, best);
+        result.best_move = Board::index_square(best);
+        result.score = alpha;
+        return result;
+    }
+
+    /// Legal moves for one position in search order.
+    struct MoveList {
+        std::array<uint8_t, Board::SQUARES> indices {};
+        size_t size {0};
+    };
+
+    /// Principal variation search of one position.
+    /// Returns the score from the point of view of `disk`, which is to move.
+    /// Returns zero without storing anything once the search has been stopped.
+    int negamax(const Disk disk, const int depth, int alpha, const int beta, const bool passed)
+    {
+        if (++nodes % CLOCK_CHECK_INTERVAL == 0
+            && (stop_signal.load(std::memory_order_relaxed)
+                || (can_stop && Clock::now() >= *deadline))) {
+            stopped = true;
+        }
+        if (stopped) {
+            return 0;
+        }
+        const Bits legal = board.legal_moves(disk);
+        if (!any(legal)) {
+            if (passed) {
+                return final_score(board, disk);
+            }
+            board.pass();
+            const int score = -negamax(opponent(disk), depth, -beta, -alpha, true);
+            board.pass();
+            return score;
+        }
+        if (depth == 0) {
+            return evaluate(board, patterns, disk);
+        }
+
+        const int original_alpha = alpha;
+        uint8_t hash_move = TableEntry::NO_MOVE;
+        if (const auto entry = table.probe(board.hash())) {
+            hash_move = entry->best_move;
+            if (entry->depth >= depth) {
+                const int score = entry->score;
+                if (entry->bound == Bound::exact
+                    || (entry->bound == Bound::lower && score >= beta)
+                    || (entry->bound == Bound::upper && score <= alpha)) {
+                    return score;
+                }
+            }
+        }
+
+        const MoveList moves = ordered_moves(disk, legal, hash_move, depth);
+        int best_score = -INFINITE_SCORE;
+        size_t best = moves.indices[0];
+        for (size_t i = 0; i < moves.size; ++i) {
+            const size_t index = moves.indices[i];
+            const int score = search_move(disk, index, depth, alpha, beta, i == 0);
+            if (stopped) {
+                return 0;
+            }
+            if (score > best_score) {
+                best_score = score;
+                best = index;
+                if (score > alpha) {
+                    alpha = score;
+                    if (alpha >= beta) {
+                        break;
+                    }
+                }
+            }
+        }
+        const Bound bound = best_score >= beta ? Bound::lower
+            : best_score > original_alpha      ? Bound::exact
+                                               : Bound::upper;
+        store(depth, best_score, bound, best);
+        return best_score;
+    }
+
+    /// Search one move with a full window for the first move and a null window for the rest,
+    /// re-searching with the full window when a later move turns out to be better.
+    int search_move(
+        const Disk disk,
+        const size_t index,
+        const int depth,
+        const int alpha,
+        const int beta,
+        const bool first
+    )
+    {
+        const ScopedMove guard(board, disk, index);
+        const ScopedPatterns patterns_guard(patterns, guard.record());
+        if (first) {
+            return -negamax(opponent(disk), depth - 1, -beta, -alpha, false);
+        }
+        int score = -negamax(opponent(disk), depth - 1, -alpha - 1, -alpha, false);
+        if (score > alpha && score < beta && !stopped) {
+            score = -negamax(opponent(disk), depth - 1, -beta, -score, false);
+        }
+        return score;
+    }
+
+    /// Order moves so the likely best ones are searched first.
+    ///
+    /// The stored best move goes first. Near the leaves moves are ordered by square weight only,
+    /// higher up moves that leave the opponent with fewer replies are tried first.
+    MoveList ordered_moves(const Disk disk, Bits legal, const uint8_t hash_move, const int depth)
+    {
+        MoveList moves;
+        std::array<int, Board::SQUARES> keys {};
+        while (any(legal)) {
+            const size_t index = pop_lowest(legal);
+            int key = SquareWeights<N>::weight_of(index);
+            if (index == hash_move) {
+                key = INFINITE_SCORE;
+            } else if (depth > 2) {
+                const ScopedMove guard(board, disk, index);
+                key -= 16 * static_cast<int>(count(board.legal_moves(opponent(disk))));
+            }
+            // Insertion sort, the move list is short
+            size_t position = moves.size++;
+            while (position > 0 && keys[position - 1] < key) {
+                keys[position] = keys[position - 1];
+                moves.indices[position] = moves.indices[position - 1];
+                --position;
+            }
+            keys[position] = key;
+            moves.indices[position] = static_cast<uint8_t>(index);
+        }
+        return moves;
+    }
+
+    [[nodiscard]] uint8_t probe_move() const
+    {
+        const auto entry = table.probe(board.hash());
+        return entry ? entry->best_move : TableEntry::NO_MOVE;
+    }
+
+    void store(const int depth, const int score, const Bound bound, const size_t best)
+    {
+        table.store(
+            board.hash(),
+            {static_cast<int16_t>(score),
+             static_cast<uint8_t>(depth),
+             bound,
+             static_cast<uint8_t>(best)}
+        );
+    }
+
+    Board board;
+    TranspositionTable& table;
+    std::optional<Clock::time_point> deadline;
+    const std::atomic<bool>& stop_signal;
+    uint64_t nodes {0};
+    bool can_stop {false};
+    bool stopped {false};
+    PatternFeatures<N> patterns;
+};
+}  // namespace
+
+/// Search for the best move for the given disk colour.
+///
+/// Uses iterative deepening negamax alpha-beta with principal variation search,
+/// transposition table cutoffs and move ordering.
+/// With a time limit the search stops at the deadline and returns the best move
+/// from the last completed depth. The first depth is always completed.
+/// The table can be reused between calls to keep results from earlier searches.
+///
+/// With more than one thread, helper threads search the same position in parallel (Lazy SMP).
+/// They share only the transposition table and fill it with results that the main thread
+/// picks up as cutoffs and move ordering. Half of the helpers start one depth ahead
+/// so that the threads spread over different depths. The result comes from the main thread.
+SearchResult search(
+    const Board& board,
+    const Disk disk,
+    const SearchLimits& limits,
+    TranspositionTable& table
+)
+{
+    const int depth = std::clamp(limits.depth, 1, MAX_SEARCH_DEPTH);
+    std::optional<Clock::time_point> deadline;
+    if (limits.time) {
+        deadline = Clock::now() + *limits.time;
+    }
+    const size_t threads = std::max<size_t>(limits.threads, 1);
+    table.new_search();
+    return board.visit([&](const auto& sized) {
+        constexpr size_t N = std::remove_cvref_t<decltype(sized)>::SIZE;
+        const auto start = Clock::now();
+        std::atomic<bool> stop_signal {false};
+        std::vector<uint64_t> helper_nodes(threads - 1);
+        std::vector<std::jthread> helpers;
+        helpers.reserve(threads - 1);
+        for (size_t thread = 1; thread < threads; ++thread) {
+            helpers.emplace_back([&, thread] {
+                Searcher<N> helper(sized, table, std::nullopt, stop_signal);
+                const int first_depth = 1 + static_cast<int>(thread % 2);
+                const auto helper_result = helper.iterative_deepening(disk, depth, first_depth);
+                helper_nodes[thread - 1] = helper_result.nodes;
+            });
+        }
+        Searcher<N> searcher(sized, table, deadline, stop_signal);
+        SearchResult result = searcher.iterative_deepening(disk, depth);
+        stop_signal.store(true, std::memory_order_relaxed);
+        helpers.clear();
+        for (const uint64_t nodes : helper_nodes) {
+            result.nodes += nodes;
+        }
+        result.elapsed
+            = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+        result.threads = threads;
+        return result;
+    });
+}
+
+}  // namespace othello
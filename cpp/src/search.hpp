@@ -0,0 +1,63 @@
+//==========================================================
+// Search header
+// Game tree search for the computer player
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+#include "transposition_table.hpp"
+
+#include <algorithm>  // std::max
+#include <chrono>
+#include <cstdint>  // uint64_t
+#include <optional>
+
+namespace othello
+{
+/// Default search depth in plies.
+constexpr int DEFAULT_SEARCH_DEPTH = 6;
+/// Maximum search depth in plies.
+constexpr int MAX_SEARCH_DEPTH = 60;
+
+/// Limits for one search.
+struct SearchLimits {
+    /// Maximum depth in plies, not counting passes
+    int depth {DEFAULT_SEARCH_DEPTH};
+    /// Wall-clock budget. Without a budget the search runs to the full depth.
+    std::optional<std::chrono::milliseconds> time {};
+    /// Number of search threads
+    size_t threads {1};
+};
+
+/// Result of a search.
+struct SearchResult {
+    /// Best move found, or empty if the side to move has no legal moves
+    std::optional<Square> best_move;
+    /// Score of the best move from the point of view of the searching side
+    int score {0};
+    /// Depth of the last completed iteration
+    int depth {0};
+    /// Number of positions visited
+    uint64_t nodes {0};
+    /// Wall-clock time used
+    std::chrono::milliseconds elapsed {0};
+    /// Number of search threads used
+    size_t threads {1};
+
+    /// Search speed in nodes per second.
+    [[nodiscard]] uint64_t nodes_per_second() const
+    {
+        return nodes * 1000 / static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 1));
+    }
+};
+
+SearchResult search(
+    const Board& board,
+    Disk disk,
+    const SearchLimits& limits,
+    TranspositionTable& table
+);
+
+}  // namespace othello
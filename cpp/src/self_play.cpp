@@ -0,0 +1,157 @@
+//==========================================================
+// Self-play source
+// Plays many computer games in parallel without output
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "self_play.hpp"
+
+#include "computer.hpp"
+#include "game.hpp"
+#include "utils.hpp"
+
+#include <algorithm>  // std::min, std::max
+#include <atomic>
+#include <cstdlib>  // std::abs
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>   // std::jthread
+#include <utility>  // std::move
+#include <vector>
+
+namespace othello
+{
+/// Seed of one game in a batch.
+///
+/// Depends only on the base seed and the game number,
+/// so the same game is played no matter which thread picks it up.
+uint64_t game_seed(const uint64_t seed, const size_t game)
+{
+    uint64_t state = seed + game;
+    return splitmix64(state);
+}
+
+/// Play one game between two computer players and return its result and record.
+///
+/// The game starts with random moves chosen with the given seed,
+/// and the computer players take turns until neither side can move.
+PlayedGame play_game(const Settings& settings, const uint64_t seed)
+{
+    // Without a fixed depth the computer plays by time like in a normal game
+    Computer black(Disk::black, settings.search, false);
+    Computer white(Disk::white, settings.search, false);
+    black.set_seed(seed);
+    white.set_seed(seed);
+
+    Game game(settings.board_size);
+    GameRecord record {settings.board_size, seed, {}};
+    FastRandom random(seed);
+    for (size_t move = 0; move < SELF_PLAY_RANDOM_MOVES; ++move) {
+        const auto moves = game.legal_moves();
+        if (moves.empty()) {
+            break;
+        }
+        const auto& chosen = moves[random.below(moves.size())];
+        game.apply(chosen);
+        record.add({chosen.disk, chosen});
+    }
+    while (!game.over()) {
+        record.add(game.step(game.side_to_move() == Disk::black ? black : white));
+    }
+    return {game.result(), std::move(record)};
+}
+
+/// Play a batch of games in parallel and aggregate the results.
+///
+/// Each worker thread takes the next game number from a shared counter.
+/// Every game has its own players and seed, so the results do not depend on the thread count.
+/// Recorded games are written in game order.
+/// Without a depth or a time limit the games are searched to `SELF_PLAY_DEFAULT_DEPTH`,
+/// so a batch with the default settings is always reproducible.
+SelfPlayResult self_play(const SelfPlaySettings& settings)
+{
+    if (settings.threads == 0) {
+        throw std::invalid_argument("Self-play needs at least one thread");
+    }
+    // Games run in parallel, so each one searches with a single thread
+    Settings game_settings = settings.game;
+    game_settings.search.threads = 1;
+    // Playing by time has to be asked for with a time limit, otherwise the depth is fixed
+    auto& search = game_settings.search;
+    if (search.depth == 0 && search.move_time == 0 && search.game_time == 0) {
+        if (search.engine == Engine::mcts) {
+            throw std::invalid_argument("Monte Carlo self-play needs a move or game time limit");
+        }
+        search.depth = SELF_PLAY_DEFAULT_DEPTH;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    SelfPlayResult result;
+    std::atomic<size_t> next {0};
+    std::mutex mutex;
+    std::exception_ptr error;
+    std::optional<GameRecordWriter> writer;
+    if (!settings.record.empty()) {
+        writer.emplace(settings.record);
+    }
+    // Games finish out of order with several threads.
+    // Records wait here until the games before them are written, so the file is in game order.
+    std::map<size_t, GameRecord> finished_records;
+    size_t next_record = 0;
+    {
+        std::vector<std::jthread> workers;
+        const size_t threads = std::min(settings.threads, std::max<size_t>(settings.games, 1));
+        workers.reserve(threads);
+        for (size_t thread = 0; thread < threads; ++thread) {
+            workers.emplace_back([&] {
+                for (size_t game = next++; game < settings.games; game = next++) {
+                    try {
+                        auto played = play_game(game_settings, game_seed(settings.seed, game));
+                        const int margin = played.result.margin();
+                        const std::scoped_lock lock(mutex);
+                        if (writer) {
+                            finished_records.emplace(game, std::move(played.record));
+                            for (auto record = finished_records.find(next_record);
+                                 record != finished_records.end();
+                                 record = finished_records.find(++next_record)) {
+                                writer->write(record->second);
+                                finished_records.erase(record);
+                            }
+                        }
+                        ++result.games;
+                        if (margin > 0) {
+                            ++result.black_wins;
+                        } else if (margin < 0) {
+                            ++result.white_wins;
+                        } else {
+                            ++result.draws;
+                        }
+                        result.black_margin += margin;
+                        result.margin += std::abs(margin);
+                    } catch (...) {
+                        const std::scoped_lock lock(mutex);
+                        error = std::current_exception();
+                        next = settings.games;
+                        return;
+                    }
+                }
+            });
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (writer) {
+        writer->flush();
+    }
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start
+    );
+    return result;
+}
+
+}  // namespace othello
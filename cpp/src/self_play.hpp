@@ -0,0 +1,92 @@
+//==========================================================
+// Self-play header
+// Plays many computer games in parallel without output
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "game.hpp"
+#include "game_record.hpp"
+#include "settings.hpp"
+
+#include <algorithm>  // std::max
+#include <chrono>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t, int64_t
+#include <filesystem>
+
+namespace othello
+{
+/// Random moves played from the start of each self-play game before the computer takes over.
+///
+/// The computer players are deterministic with a fixed search depth,
+/// so the random opening is what makes the games differ from each other.
+constexpr size_t SELF_PLAY_RANDOM_MOVES = 4;
+
+/// Search depth for self-play games that set neither a depth nor a time limit.
+///
+/// A fixed depth keeps the batch fast and the results reproducible.
+constexpr int SELF_PLAY_DEFAULT_DEPTH = 4;
+
+/// Settings for a batch of self-play games.
+struct SelfPlaySettings {
+    /// Board size and computer player settings shared by every game
+    Settings game;
+    /// Number of games to play
+    size_t games {1};
+    /// Number of games played at the same time
+    size_t threads {1};
+    /// Base seed, each game gets its own seed derived from this and the game number
+    uint64_t seed {0};
+    /// Game record file the games are appended to, empty to not record them
+    std::filesystem::path record {};
+};
+
+/// Result and record of one self-play game.
+struct PlayedGame {
+    GameResult result;
+    GameRecord record;
+};
+
+/// Aggregated results of a batch of self-play games.
+struct SelfPlayResult {
+    size_t games {0};
+    size_t black_wins {0};
+    size_t draws {0};
+    size_t white_wins {0};
+    /// Sum of final disk differences from the point of view of black
+    int64_t black_margin {0};
+    /// Sum of absolute final disk differences
+    int64_t margin {0};
+    /// Wall-clock time used
+    std::chrono::milliseconds elapsed {0};
+
+    /// Average final disk difference from the point of view of black.
+    [[nodiscard]] double average_black_margin() const
+    {
+        return games > 0 ? static_cast<double>(black_margin) / static_cast<double>(games) : 0.0;
+    }
+
+    /// Average winning margin, draws count as zero.
+    [[nodiscard]] double average_margin() const
+    {
+        return games > 0 ? static_cast<double>(margin) / static_cast<double>(games) : 0.0;
+    }
+
+    /// Number of games played per second.
+    [[nodiscard]] double games_per_second() const
+    {
+        return static_cast<double>(games) * 1000.0
+            / static_cast<double>(std::max<int64_t>(elapsed.count(), 1));
+    }
+};
+
+/// Seed of one game in a batch.
+[[nodiscard]] uint64_t game_seed(uint64_t seed, size_t game);
+
+[[nodiscard]] PlayedGame play_game(const Settings& settings, uint64_t seed);
+
+SelfPlayResult self_play(const SelfPlaySettings& settings);
+
+}  // namespace othello
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <format>
+#include <string>
+#include <string_view>
 
 namespace othello
 {
@@ -17,13 +19,55 @@ static constexpr size_t MIN_BOARD_SIZE = 4;
 static constexpr size_t MAX_BOARD_SIZE = 10;
 /// Default board size when none is given.
 static constexpr size_t DEFAULT_BOARD_SIZE = 8;
+/// Default number of empty squares left when the computer player starts solving the game exactly.
+static constexpr size_t DEFAULT_ENDGAME_EMPTIES = 16;
+/// Default UCT exploration constant for Monte Carlo tree search.
+static constexpr double DEFAULT_EXPLORATION = 1.4;
+
+/// Search algorithm used by the computer player.
+enum class Engine { alpha_beta, mcts };
+
+/// Returns the command line name of the engine.
+[[nodiscard]] constexpr std::string_view engine_name(const Engine engine)
+{
+    return engine == Engine::mcts ? "mcts" : "alphabeta";
+}
+
+/// Computer player search settings.
+struct SearchSettings {
+    bool operator==(const SearchSettings& other) const = default;
+
+    /// Fixed search depth in plies, zero searches by time instead
+    int depth {0};
+    /// Time limit for one move in milliseconds, zero picks a random limit between 1 and 2 seconds
+    int move_time {0};
+    /// Total thinking time for one game in seconds, zero for no limit
+    int game_time {0};
+    /// Number of search threads
+    size_t threads {1};
+    /// Solve the game exactly when at most this many squares are empty, zero to disable
+    size_t endgame {DEFAULT_ENDGAME_EMPTIES};
+    Engine engine {Engine::alpha_beta};
+    /// UCT exploration constant for Monte Carlo tree search
+    double exploration {DEFAULT_EXPLORATION};
+    /// Opening book file consulted before searching, empty for no book
+    std::string book {};
+    /// Tablebase file for perfect play in the positions it covers, empty for no tablebase
+    std::string tablebase {};
+};
 
 /// Player settings.
 struct PlayerSettings {
-    explicit PlayerSettings(const bool show_helpers, const bool check_mode, const bool test_mode) :
+    explicit PlayerSettings(
+        const bool show_helpers,
+        const bool check_mode,
+        const bool test_mode,
+        const SearchSettings search = {}
+    ) :
         show_helpers(show_helpers),
         check_mode(check_mode),
-        test_mode(test_mode)
+        test_mode(test_mode),
+        search(search)
     {}
 
     PlayerSettings() : show_helpers(true), check_mode(false), test_mode(false) {}
@@ -36,10 +80,28 @@ struct PlayerSettings {
             "PlayerSettings:\n"
             "  show_helpers: {}\n"
             "  check_mode:   {}\n"
-            "  test_mode:    {}\n",
+            "  test_mode:    {}\n"
+            "  search_depth: {}\n"
+            "  move_time:    {}\n"
+            "  game_time:    {}\n"
+            "  threads:      {}\n"
+            "  endgame:      {}\n"
+            "  engine:       {}\n"
+            "  exploration:  {}\n"
+            "  book:         {}\n"
+            "  tablebase:    {}\n",
             player_settings.show_helpers ? "true" : "false",
             player_settings.check_mode ? "true" : "false",
-            player_settings.test_mode ? "true" : "false"
+            player_settings.test_mode ? "true" : "false",
+            player_settings.search.depth,
+            player_settings.search.move_time,
+            player_settings.search.game_time,
+            player_settings.search.threads,
+            player_settings.search.endgame,
+            engine_name(player_settings.search.engine),
+            player_settings.search.exploration,
+            player_settings.search.book,
+            player_settings.search.tablebase
         );
         return out;
     }
@@ -47,6 +109,7 @@ struct PlayerSettings {
     bool show_helpers;
     bool check_mode;
     bool test_mode;
+    SearchSettings search;
 };
 
 /// Game settings.
@@ -58,7 +121,8 @@ struct Settings {
         const bool show_helpers,
         const bool show_log,
         const bool test_mode,
-        const bool use_defaults
+        const bool use_defaults,
+        const SearchSettings search = {}
     ) :
         board_size(board_size),
         autoplay_mode(autoplay_mode),
@@ -66,7 +130,8 @@ struct Settings {
         show_helpers(show_helpers),
         show_log(show_log),
         test_mode(test_mode),
-        use_defaults(use_defaults)
+        use_defaults(use_defaults),
+        search(search)
     {}
 
     Settings() :
@@ -82,7 +147,7 @@ struct Settings {
     /// Get player setting values from overall game settings.
     [[nodiscard]] PlayerSettings to_player_settings() const
     {
-        return PlayerSettings(show_helpers, check_mode, test_mode);
+        return PlayerSettings(show_helpers, check_mode, test_mode, search);
     }
 
     friend std::ostream& operator<<(std::ostream& out, const Settings& settings)
@@ -95,14 +160,32 @@ struct Settings {
             "  use_defaults: {}\n"
             "  show_helpers: {}\n"
             "  show_log: {}\n"
-            "  test_mode: {}",
+            "  test_mode: {}\n"
+            "  search_depth: {}\n"
+            "  move_time: {}\n"
+            "  game_time: {}\n"
+            "  threads: {}\n"
+            "  endgame: {}\n"
+            "  engine: {}\n"
+            "  exploration: {}\n"
+            "  book: {}\n"
+            "  tablebase: {}",
             settings.board_size,
             settings.autoplay_mode,
             settings.check_mode,
             settings.use_defaults,
             settings.show_helpers,
             settings.show_log,
-            settings.test_mode
+            settings.test_mode,
+            settings.search.depth,
+            settings.search.move_time,
+            settings.search.game_time,
+            settings.search.threads,
+            settings.search.endgame,
+            engine_name(settings.search.engine),
+            settings.search.exploration,
+            settings.search.book,
+            settings.search.tablebase
         );
         return out;
     }
@@ -114,6 +197,7 @@ struct Settings {
     bool show_log;
     bool test_mode;
     bool use_defaults;
+    SearchSettings search;
 };
 }  // namespace othello
 
@@ -0,0 +1,286 @@
+//==========================================================
+// Sized board header
+// Board state specialised for one compile-time board size
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "bitboard.hpp"
+#include "models.hpp"
+#include "zobrist.hpp"
+
+#include <utility>  // std::forward
+
+namespace othello
+{
+/// Record of one placed disk that is enough to take the move back.
+template<typename Bits>
+struct MoveUndo {
+    /// Opponent disks that were flipped by the move
+    Bits flipped {};
+    /// Board index of the placed disk
+    size_t index {0};
+    /// Colour of the placed disk
+    Disk disk {Disk::empty};
+    /// Position hash before the move
+    uint64_t hash {0};
+    /// Side to move before the move
+    Disk side {Disk::black};
+};
+
+/// Board state for an N x N board with one bit mask per disk colour.
+///
+/// All geometry is known at compile time so loops over squares and directions
+/// can be unrolled and constant folded for each board size.
+template<size_t N>
+class SizedBoard
+{
+public:
+    using Geometry = BoardGeometry<N>;
+    using Bits = typename Geometry::Bits;
+    using Undo = MoveUndo<Bits>;
+
+    static constexpr size_t SIZE = N;
+    static constexpr size_t SQUARES = Geometry::SQUARES;
+
+    /// Initialize board with the starting disk positions.
+    constexpr SizedBoard()
+    {
+        constexpr size_t row = N % 2 == 0 ? (N - 1) / 2 : (N - 1) / 2 - 1;
+        constexpr size_t col = N / 2;
+        set(row * N + row, Disk::white);
+        set(row * N + col, Disk::black);
+        set(col * N + row, Disk::black);
+        set(col * N + col, Disk::white);
+    }
+
+    /// Initialize board from disk masks and the side to move.
+    constexpr SizedBoard(const Bits black, const Bits white, const Disk side = Disk::black) :
+        black(black),
+        white(white),
+        side(side),
+        key(compute_hash(black, white, side))
+    {}
+
+    bool operator==(const SizedBoard& other) const = default;
+
+    /// Returns the disk mask for the given colour, or empty squares for `Disk::empty`.
+    [[nodiscard]] constexpr Bits disks(const Disk disk) const
+    {
+        switch (disk) {
+            case Disk::black:
+                return black;
+            case Disk::white:
+                return white;
+            default:
+                return empty();
+        }
+    }
+
+    /// Mask of all empty squares.
+    [[nodiscard]] constexpr Bits empty() const
+    {
+        return Geometry::FULL & ~(black | white);
+    }
+
+    /// Mask of all squares where the given disk colour can be placed.
+    [[nodiscard]] constexpr Bits legal_moves(const Disk disk) const
+    {
+        return disk == Disk::black ? Geometry::legal_moves(black, white)
+                                   : Geometry::legal_moves(white, black);
+    }
+
+    /// Opponent disks that placing the given disk colour at the index would flip.
+    [[nodiscard]] constexpr Bits flips(const Disk disk, const size_t index) const
+    {
+        return disk == Disk::black ? Geometry::flips(black, white, index)
+                                   : Geometry::flips(white, black, index);
+    }
+
+    /// Place a disk to an empty square and flip the captured disks.
+    /// The opponent of the placed disk is to move next.
+    /// Returns the flipped disks. Does not validate the move.
+    constexpr Bits place(const Disk disk, const size_t index)
+    {
+        const Bits flipped = flips(disk, index);
+        const Bits changed = flipped | square_bit<Bits>(index);
+        if (disk == Disk::black) {
+            black |= changed;
+            white &= ~flipped;
+        } else {
+            white |= changed;
+            black &= ~flipped;
+        }
+        // Update hash only for the changed squares
+        key ^= ZOBRIST.disk(disk, index);
+        Bits remaining = flipped;
+        while (any(remaining)) {
+            key ^= ZOBRIST.flip[pop_lowest(remaining)];
+        }
+        set_side(opponent(disk));
+        return flipped;
+    }
+
+    /// Place a disk and return the record needed to take the move back with `unmake_move`.
+    /// Does not validate the move.
+    constexpr Undo make_move(const Disk disk, const size_t index)
+    {
+        const uint64_t previous_hash = key;
+        const Disk previous_side = side;
+        return {place(disk, index), index, disk, previous_hash, previous_side};
+    }
+
+    /// Take back a move made with `make_move`.
+    /// Moves must be taken back in reverse order.
+    constexpr void unmake_move(const Undo& undo)
+    {
+        const Bits placed = square_bit<Bits>(undo.index);
+        if (undo.disk == Disk::black) {
+            black ^= undo.flipped | placed;
+            white |= undo.flipped;
+        } else {
+            white ^= undo.flipped | placed;
+            black |= undo.flipped;
+        }
+        key = undo.hash;
+        side = undo.side;
+    }
+
+    /// Skip a turn when the side to move has no legal moves.
+    constexpr void pass()
+    {
+        set_side(opponent(side));
+    }
+
+    /// The disk colour whose turn it is.
+    [[nodiscard]] constexpr Disk side_to_move() const
+    {
+        return side;
+    }
+
+    /// Zobrist hash of the position including the side to move.
+    [[nodiscard]] constexpr uint64_t hash() const
+    {
+        return key;
+    }
+
+    /// Returns the disk at the given board index.
+    [[nodiscard]] constexpr Disk get(const size_t index) const
+    {
+        const Bits bit = square_bit<Bits>(index);
+        if (any(black & bit)) {
+            return Disk::black;
+        }
+        return any(white & bit) ? Disk::white : Disk::empty;
+    }
+
+    /// Sets the disk at the given board index.
+    constexpr void set(const size_t index, const Disk disk)
+    {
+        key ^= ZOBRIST.disk(get(index), index) ^ ZOBRIST.disk(disk, index);
+        const Bits bit = square_bit<Bits>(index);
+        black &= ~bit;
+        white &= ~bit;
+        if (disk == Disk::black) {
+            black |= bit;
+        } else if (disk == Disk::white) {
+            white |= bit;
+        }
+    }
+
+    /// Number of disks of the given colour.
+    [[nodiscard]] constexpr size_t count(const Disk disk) const
+    {
+        return othello::count(disks(disk));
+    }
+
+    /// Returns the total score.
+    /// Positive value means more white disks and negative means more black disks.
+    [[nodiscard]] constexpr int score() const
+    {
+        return static_cast<int>(othello::count(white)) - static_cast<int>(othello::count(black));
+    }
+
+    /// Map square to board index.
+    [[nodiscard]] static constexpr size_t square_index(const Square& square)
+    {
+        return static_cast<size_t>(square.y) * N + static_cast<size_t>(square.x);
+    }
+
+    /// Map board index to square.
+    [[nodiscard]] static constexpr Square index_square(const size_t index)
+    {
+        return Geometry::INDEX_SQUARES[index];
+    }
+
+    /// Compute the hash of a position from scratch.
+    [[nodiscard]] static constexpr uint64_t compute_hash(Bits black, Bits white, const Disk side)
+    {
+        uint64_t hash = side == Disk::white ? ZOBRIST.white_to_move : 0;
+        while (any(black)) {
+            hash ^= ZOBRIST.black[pop_lowest(black)];
+        }
+        while (any(white)) {
+            hash ^= ZOBRIST.white[pop_lowest(white)];
+        }
+        return hash;
+    }
+
+private:
+    /// Update side to move and the side component of the hash.
+    constexpr void set_side(const Disk next)
+    {
+        if (next != side) {
+            key ^= ZOBRIST.white_to_move;
+            side = next;
+        }
+    }
+
+    Bits black {};
+    Bits white {};
+    Disk side {Disk::black};
+    uint64_t key {0};
+};
+
+/// Makes a move for the lifetime of the guard and takes it back when the guard goes out of scope.
+///
+/// Lets search code walk the game tree in place without copying the board:
+/// ```
+/// {
+///     ScopedMove guard(board, Disk::black, index);
+///     search(board, depth - 1);
+/// }
+/// ```
+template<typename BoardType>
+class ScopedMove
+{
+public:
+    template<typename... Args>
+    explicit ScopedMove(BoardType& board, Args&&... args) :
+        board(board),
+        undo(board.make_move(std::forward<Args>(args)...))
+    {}
+
+    ~ScopedMove()
+    {
+        board.unmake_move(undo);
+    }
+
+    ScopedMove(const ScopedMove&) = delete;
+    ScopedMove& operator=(const ScopedMove&) = delete;
+    ScopedMove(ScopedMove&&) = delete;
+    ScopedMove& operator=(ScopedMove&&) = delete;
+
+    /// Record of the move made by this guard.
+    [[nodiscard]] const typename BoardType::Undo& record() const
+    {
+        return undo;
+    }
+
+private:
+    BoardType& board;
+    typename BoardType::Undo undo;
+};
+
+}  // namespace othello
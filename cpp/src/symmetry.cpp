@@ -0,0 +1,39 @@
+//==========================================================
+// Symmetry source
+// Position keys shared by the symmetric variants of a position
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "symmetry.hpp"
+
+#include <type_traits>  // std::remove_cvref_t
+
+namespace othello
+{
+/// Canonical key of the position, the same for all its symmetric variants.
+CanonicalPosition canonical_position(const Board& board, const Disk disk)
+{
+    return board.visit([disk](const auto& sized) { return canonical_position(sized, disk); });
+}
+
+/// Map a move on the board to a board index in the canonical orientation.
+size_t to_canonical_move(const Board& board, const Square& square, const unsigned symmetry)
+{
+    return board.visit([&](const auto& sized) {
+        using Sized = std::remove_cvref_t<decltype(sized)>;
+        return Sized::Geometry::transform(Sized::square_index(square), symmetry);
+    });
+}
+
+/// Map a board index in the canonical orientation back to a move on the board.
+Square from_canonical_move(const Board& board, const size_t index, const unsigned symmetry)
+{
+    return board.visit([&](const auto& sized) {
+        using Sized = std::remove_cvref_t<decltype(sized)>;
+        using Geometry = typename Sized::Geometry;
+        return Sized::index_square(Geometry::transform(index, Geometry::inverse(symmetry)));
+    });
+}
+
+}  // namespace othello
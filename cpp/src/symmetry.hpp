@@ -0,0 +1,50 @@
+//==========================================================
+// Symmetry header
+// Position keys shared by the symmetric variants of a position
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+#include "sized_board.hpp"
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+
+namespace othello
+{
+/// Position hash that is the same for all eight symmetric variants of a position.
+struct CanonicalPosition {
+    /// Smallest Zobrist hash over the board symmetries
+    uint64_t key {0};
+    /// Symmetry that maps the board to the orientation with the smallest hash
+    unsigned symmetry {0};
+};
+
+/// Hash the position in all eight orientations and pick the smallest,
+/// so symmetric positions share one key.
+template<size_t N>
+[[nodiscard]] constexpr CanonicalPosition
+canonical_position(const SizedBoard<N>& board, const Disk disk)
+{
+    using Geometry = BoardGeometry<N>;
+    CanonicalPosition canonical;
+    for (unsigned symmetry = 0; symmetry < Geometry::SYMMETRIES; ++symmetry) {
+        const uint64_t key = SizedBoard<N>::compute_hash(
+            Geometry::transform_bits(board.disks(Disk::black), symmetry),
+            Geometry::transform_bits(board.disks(Disk::white), symmetry),
+            disk
+        );
+        if (symmetry == 0 || key < canonical.key) {
+            canonical = {key, symmetry};
+        }
+    }
+    return canonical;
+}
+
+[[nodiscard]] CanonicalPosition canonical_position(const Board& board, Disk disk);
+[[nodiscard]] size_t to_canonical_move(const Board& board, const Square& square, unsigned symmetry);
+[[nodiscard]] Square from_canonical_move(const Board& board, size_t index, unsigned symmetry);
+
+}  // namespace othello
@@ -0,0 +1,277 @@
+//==========================================================
+// Tablebase source
+// Perfect-play database of solved positions
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "tablebase.hpp"
+
+#include "symmetry.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>  // std::max
+#include <array>
+#include <bit>  // std::bit_ceil
+#include <cstdio>   // std::fflush
+#include <cstring>  // std::memcpy
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>  // std::remove_cvref_t
+#include <utility>      // std::move
+
+namespace othello
+{
+namespace
+{
+constexpr std::array<char, 8> TABLEBASE_MAGIC {'O', 'T', 'H', 'T', 'B', 'A', 'S', 'E'};
+constexpr uint32_t TABLEBASE_VERSION = 2;
+static_assert(
+    MAX_BOARD_SIZE * MAX_BOARD_SIZE <= std::numeric_limits<int8_t>::max(),
+    "disk differences are stored in one signed byte"
+);
+
+/// Number of slots the generator starts with
+constexpr size_t INITIAL_CAPACITY = size_t {1} << 16;
+
+/// File header in front of the hash table slots.
+struct TablebaseHeader {
+    std::array<char, 8> magic {TABLEBASE_MAGIC};
+    uint32_t version {TABLEBASE_VERSION};
+    uint32_t board_size {0};
+    uint64_t capacity {0};
+    uint64_t count {0};
+};
+
+/// Copy of the occupied slots in a table with the given power of two capacity.
+std::vector<TablebaseSlot> rehash(const std::span<const TablebaseSlot> slots, const size_t capacity)
+{
+    std::vector<TablebaseSlot> table(capacity);
+    for (const auto& slot : slots) {
+        if (slot.occupied != 0) {
+            table[TablebaseSlot::find(table, slot.key)] = slot;
+        }
+    }
+    return table;
+}
+
+/// Look up the position in a table of slots.
+std::optional<TablebaseMove> lookup_slots(
+    const std::span<const TablebaseSlot> slots,
+    const Board& board,
+    const Disk disk
+)
+{
+    const auto [key, symmetry] = canonical_position(board, disk);
+    const auto& slot = slots[TablebaseSlot::find(slots, key)];
+    if (slot.occupied == 0) {
+        return std::nullopt;
+    }
+    return TablebaseMove {from_canonical_move(board, slot.move, symmetry), slot.score};
+}
+
+size_t size_of(const Board& board)
+{
+    return board.visit([](const auto& sized) {
+        return std::remove_cvref_t<decltype(sized)>::SIZE;
+    });
+}
+}  // namespace
+
+/// Map the tablebase file into memory and check its header.
+Tablebase::Tablebase(const std::filesystem::path& path) : file(path)
+{
+    TablebaseHeader header;
+    if (file.size() < sizeof(TablebaseHeader)) {
+        throw std::runtime_error(fmt::format("Invalid tablebase: {}", path.string()));
+    }
+    std::memcpy(&header, file.data(), sizeof(TablebaseHeader));
+    const bool power_of_two
+        = header.capacity > 0 && (header.capacity & (header.capacity - 1)) == 0;
+    if (header.magic != TABLEBASE_MAGIC || header.version != TABLEBASE_VERSION
+        || header.board_size < MIN_BOARD_SIZE || header.board_size > MAX_BOARD_SIZE
+        || !power_of_two || header.count >= header.capacity
+        || header.capacity > (file.size() - sizeof(TablebaseHeader)) / sizeof(TablebaseSlot)
+        || file.size() != sizeof(TablebaseHeader) + header.capacity * sizeof(TablebaseSlot)) {
+        throw std::runtime_error(fmt::format("Invalid tablebase: {}", path.string()));
+    }
+    size_of_board = header.board_size;
+    count = header.count;
+    slots = {
+        reinterpret_cast<const TablebaseSlot*>(file.data() + sizeof(TablebaseHeader)),
+        static_cast<size_t>(header.capacity)
+    };
+}
+
+/// Perfect-play move for the given position,
+/// or nothing if the position is not in the tablebase.
+std::optional<TablebaseMove> Tablebase::lookup(const Board& board, const Disk disk) const
+{
+    if (size_of(board) != size_of_board) {
+        return std::nullopt;
+    }
+    return lookup_slots(slots, board, disk);
+}
+
+/// Number of positions in the tablebase.
+size_t Tablebase::size() const
+{
+    return count;
+}
+
+/// Board size the tablebase was generated for.
+size_t Tablebase::board_size() const
+{
+    return size_of_board;
+}
+
+TablebaseGenerator::TablebaseGenerator(TablebaseSettings settings) :
+    settings(std::move(settings)),
+    slots(INITIAL_CAPACITY)
+{
+    if (this->settings.board_size < MIN_BOARD_SIZE || this->settings.board_size > MAX_BOARD_SIZE) {
+        throw std::invalid_argument(
+            fmt::format("Unsupported board size: {}", this->settings.board_size)
+        );
+    }
+}
+
+/// Solve the positions from the root positions onwards.
+void TablebaseGenerator::generate()
+{
+    Board(settings.board_size).visit([&](auto& start) {
+        using Sized = std::remove_cvref_t<decltype(start)>;
+        if (settings.empties == 0 || settings.empties >= othello::count(start.empty())) {
+            solve(start, Disk::black, false);
+            return;
+        }
+        std::mt19937 random(settings.seed);
+        for (size_t game = 0; game < settings.games; ++game) {
+            Sized board = start;
+            Disk disk = Disk::black;
+            bool over = false;
+            while (!over && othello::count(board.empty()) > settings.empties) {
+                auto legal = board.legal_moves(disk);
+                if (!any(legal)) {
+                    disk = opponent(disk);
+                    legal = board.legal_moves(disk);
+                    over = !any(legal);
+                    continue;
+                }
+                std::uniform_int_distribution<size_t> pick(0, othello::count(legal) - 1);
+                for (size_t skip = pick(random); skip > 0; --skip) {
+                    pop_lowest(legal);
+                }
+                board.place(disk, lowest_index(legal));
+                disk = opponent(disk);
+            }
+            if (!over) {
+                solve(board, disk, false);
+            }
+            if (settings.verbose) {
+                fmt::print("\r  {}/{} games, {} positions", game + 1, settings.games, count);
+                std::fflush(stdout);
+            }
+        }
+        if (settings.verbose) {
+            fmt::print("\n");
+        }
+    });
+}
+
+/// Solve the given position and every position reachable from it.
+void TablebaseGenerator::add(const Board& root)
+{
+    if (size_of(root) != settings.board_size) {
+        throw std::invalid_argument(
+            fmt::format("Position does not match tablebase board size {}", settings.board_size)
+        );
+    }
+    Board board = root;
+    board.visit([&](auto& sized) { solve(sized, sized.side_to_move(), false); });
+}
+
+/// Write the table to a file that `Tablebase` maps into memory.
+/// The file gets the smallest table that is at most half full.
+void TablebaseGenerator::write(const std::filesystem::path& path) const
+{
+    const auto table = rehash(slots, std::bit_ceil(std::max<size_t>(2 * count, 2)));
+    TablebaseHeader header;
+    header.board_size = static_cast<uint32_t>(settings.board_size);
+    header.capacity = table.size();
+    header.count = count;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(
+        reinterpret_cast<const char*>(table.data()),
+        static_cast<std::streamsize>(table.size() * sizeof(TablebaseSlot))
+    );
+    if (!file) {
+        throw std::runtime_error(fmt::format("Failed to write tablebase: {}", path.string()));
+    }
+}
+
+/// Perfect-play move for a solved position.
+std::optional<TablebaseMove> TablebaseGenerator::lookup(const Board& board, const Disk disk) const
+{
+    if (size_of(board) != settings.board_size) {
+        return std::nullopt;
+    }
+    return lookup_slots(slots, board, disk);
+}
+
+/// Number of solved positions.
+size_t TablebaseGenerator::size() const
+{
+    return count;
+}
+
+/// Returns the final disk difference with perfect play from the point of view of `disk`,
+/// and stores the result for every position where `disk` has a legal move.
+template<size_t N>
+int TablebaseGenerator::solve(SizedBoard<N>& board, const Disk disk, const bool passed)
+{
+    auto legal = board.legal_moves(disk);
+    if (!any(legal)) {
+        if (passed) {
+            return static_cast<int>(board.count(disk))
+                - static_cast<int>(board.count(opponent(disk)));
+        }
+        return -solve(board, opponent(disk), true);
+    }
+    const auto [key, symmetry] = canonical_position(board, disk);
+    if (const auto& slot = slots[TablebaseSlot::find(slots, key)]; slot.occupied != 0) {
+        return slot.score;
+    }
+    int best_score = std::numeric_limits<int>::min();
+    size_t best_move = 0;
+    while (any(legal)) {
+        const size_t index = pop_lowest(legal);
+        const ScopedMove guard(board, disk, index);
+        const int score = -solve(board, opponent(disk), false);
+        if (score > best_score) {
+            best_score = score;
+            best_move = index;
+        }
+    }
+    insert(key, BoardGeometry<N>::transform(best_move, symmetry), best_score);
+    return best_score;
+}
+
+/// Store a solved position, growing the table to keep it at most half full.
+void TablebaseGenerator::insert(const uint64_t key, const size_t move, const int score)
+{
+    if (2 * (count + 1) > slots.size()) {
+        slots = rehash(slots, 2 * slots.size());
+    }
+    TablebaseSlot& slot = slots[TablebaseSlot::find(slots, key)];
+    if (slot.occupied == 0) {
+        ++count;
+    }
+    slot = {key, static_cast<uint8_t>(move), static_cast<int8_t>(score), 1};
+}
+
+}  // namespace othello
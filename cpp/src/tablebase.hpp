@@ -0,0 +1,124 @@
+//==========================================================
+// Tablebase header
+// Perfect-play database of solved positions
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "board.hpp"
+#include "mapped_file.hpp"
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, int8_t, uint64_t
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace othello
+{
+/// Perfect-play move and result for a position.
+struct TablebaseMove {
+    Square square;
+    /// Final disk difference with perfect play from the point of view of the side to move
+    int score {0};
+};
+
+/// Solved position in one slot of an open addressing hash table.
+///
+/// The full canonical position key identifies the position,
+/// so a hit is always the same position and never one that only shares some of the key bits.
+struct TablebaseSlot {
+    /// Canonical hash of the position and the side to move
+    uint64_t key {0};
+    /// Best move as a board index in the canonical orientation
+    uint8_t move {0};
+    /// Final disk difference with perfect play from the point of view of the side to move
+    int8_t score {0};
+    /// Zero for an empty slot
+    uint8_t occupied {0};
+    /// Keeps slots aligned to 8 bytes in the file
+    std::array<uint8_t, 5> padding {};
+
+    /// Linear probe for the slot holding the key, or the empty slot where it would go.
+    [[nodiscard]] static constexpr size_t
+    find(const std::span<const TablebaseSlot> slots, const uint64_t key)
+    {
+        const size_t mask = slots.size() - 1;
+        size_t index = key & mask;
+        while (slots[index].occupied != 0 && slots[index].key != key) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+};
+
+static_assert(sizeof(TablebaseSlot) == 16, "tablebase slots are read directly from the file");
+
+/// Read-only tablebase mapped into memory.
+///
+/// Answers in constant time with the perfect-play move for every position it covers,
+/// without any search.
+class Tablebase
+{
+public:
+    explicit Tablebase(const std::filesystem::path& path);
+
+    [[nodiscard]] std::optional<TablebaseMove> lookup(const Board& board, Disk disk) const;
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t board_size() const;
+
+private:
+    MappedFile file;
+    std::span<const TablebaseSlot> slots;
+    size_t count {0};
+    size_t size_of_board {0};
+};
+
+/// Settings for generating a tablebase.
+struct TablebaseSettings {
+    size_t board_size {MIN_BOARD_SIZE};
+    /// Solve positions with at most this many empty squares, 0 solves the whole game
+    size_t empties {0};
+    /// Number of random games played to reach the positions with `empties` empty squares
+    size_t games {1000};
+    /// Seed for the random games
+    unsigned seed {0};
+    /// Print progress
+    bool verbose {true};
+};
+
+/// Generates a tablebase by forward enumeration.
+///
+/// Every position reachable from the root positions is solved exactly with negamax
+/// over the full game tree. Each position is solved only once:
+/// results are kept in the table under the canonical key, so the symmetric variants
+/// and transpositions of a position are looked up instead of searched again.
+/// Without an empty square limit the root is the start position and the table covers
+/// the whole game. With a limit the roots are the positions with that many empty squares
+/// reached by random games, which suits boards too large to solve completely.
+class TablebaseGenerator
+{
+public:
+    explicit TablebaseGenerator(TablebaseSettings settings);
+
+    void generate();
+    void add(const Board& root);
+    void write(const std::filesystem::path& path) const;
+    [[nodiscard]] std::optional<TablebaseMove> lookup(const Board& board, Disk disk) const;
+    [[nodiscard]] size_t size() const;
+
+private:
+    template<size_t N>
+    int solve(SizedBoard<N>& board, Disk disk, bool passed);
+
+    void insert(uint64_t key, size_t move, int score);
+
+    TablebaseSettings settings;
+    std::vector<TablebaseSlot> slots;
+    size_t count {0};
+};
+
+}  // namespace othello
@@ -0,0 +1,107 @@
+//==========================================================
+// Tablebase generator main
+// Generate a perfect-play tablebase for the computer player
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "colorprint.hpp"
+#include "cxxopts.hpp"
+#include "tablebase.hpp"
+#include "version.hpp"
+
+#include <chrono>
+#include <string>
+
+inline cxxopts::Options cli_arguments()
+{
+    cxxopts::Options options("othello_tablebase", "Generate a tablebase for Othello C++");
+    options.custom_help("[OPTIONS]");
+    options.positional_help(
+        fmt::format(
+            "[SIZE]\n\nArguments:\n  [SIZE]            Optional board size ({}..{})",
+            othello::MIN_BOARD_SIZE,
+            othello::MAX_BOARD_SIZE
+        )
+    );
+
+    options.add_options("Positional")(
+        "size",
+        fmt::format(
+            "Optional board size ({}..{})", othello::MIN_BOARD_SIZE, othello::MAX_BOARD_SIZE
+        ),
+        cxxopts::value<size_t>()->default_value(std::to_string(othello::MIN_BOARD_SIZE))
+    );
+
+    // clang-format off
+    options.add_options("Optional")
+        ("o,output", "Tablebase file to write", cxxopts::value<std::string>()->default_value("othello.tablebase"))
+        ("empties", "Solve positions with at most this many empty squares, 0 solves the whole game", cxxopts::value<size_t>()->default_value("0"))
+        ("games", "Number of random games to reach the positions to solve with --empties", cxxopts::value<size_t>()->default_value("1000"))
+        ("seed", "Seed for the random games", cxxopts::value<unsigned>()->default_value("0"))
+        ("h,help", "Print help and exit", cxxopts::value<bool>())
+        ("v,version", "Print version and exit", cxxopts::value<bool>());
+    // clang-format on
+
+    options.parse_positional({"size"});
+
+    return options;
+}
+
+int main(const int argc, const char* argv[])
+{
+    try {
+        auto options = cli_arguments();
+        const auto parsed_args = options.parse(argc, argv);
+
+        if (parsed_args["version"].as<bool>()) {
+            fmt::print("{}\n", version::version_info());
+            return 0;
+        }
+        if (parsed_args["help"].as<bool>()) {
+            fmt::print("{}", options.help({"Optional"}));
+            return 0;
+        }
+
+        othello::TablebaseSettings settings;
+        settings.board_size = parsed_args["size"].as<size_t>();
+        settings.empties = parsed_args["empties"].as<size_t>();
+        settings.games = parsed_args["games"].as<size_t>();
+        settings.seed = parsed_args["seed"].as<unsigned>();
+        const std::string output = parsed_args["output"].as<std::string>();
+
+        print_green_bold("OTHELLO TABLEBASE - C++\n");
+        if (settings.empties == 0) {
+            fmt::println("Solving the whole game on board size {}", settings.board_size);
+        } else {
+            fmt::println(
+                "Solving positions with {} empty squares from {} games on board size {}",
+                settings.empties,
+                settings.games,
+                settings.board_size
+            );
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        othello::TablebaseGenerator generator(settings);
+        generator.generate();
+        generator.write(output);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start
+        );
+        fmt::println(
+            "Wrote {} positions to {} in {:.1f} s",
+            generator.size(),
+            output,
+            static_cast<double>(elapsed.count()) / 1000.0
+        );
+    } catch (const cxxopts::exceptions::exception& e) {
+        print_error(e.what());
+        return 1;
+    } catch (const std::exception& e) {
+        print_error(e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+//==========================================================
+// Transposition table source
+// Shared lock-free cache of searched positions
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#include "transposition_table.hpp"
+
+#include <algorithm>  // std::max
+#include <bit>        // std::bit_floor
+
+namespace othello
+{
+// Packed slot data layout, from the lowest bit:
+// score: 16 bits, depth: 8 bits, bound: 8 bits, best move: 8 bits, generation: 8 bits.
+// Generation is never zero for a stored entry, so an empty slot always has zero data.
+constexpr int DEPTH_SHIFT = 16;
+constexpr int BOUND_SHIFT = 24;
+constexpr int MOVE_SHIFT = 32;
+constexpr int GENERATION_SHIFT = 40;
+
+TranspositionTable::TranspositionTable(const size_t megabytes)
+{
+    const size_t bytes = megabytes * 1024 * 1024;
+    const size_t count = std::bit_floor(std::max<size_t>(bytes / sizeof(Slot), 1));
+    slots = std::make_unique<Slot[]>(count);
+    mask = count - 1;
+}
+
+/// Look up the stored result for the given position hash.
+std::optional<TableEntry> TranspositionTable::probe(const uint64_t hash) const
+{
+    const Slot& entry = slot(hash);
+    const uint64_t data = entry.data.load(std::memory_order_relaxed);
+    const uint64_t key = entry.key.load(std::memory_order_relaxed);
+    if (data == 0 || (key ^ data) != hash) {
+        return std::nullopt;
+    }
+    return unpack(data);
+}
+
+/// Store a search result for the given position hash.
+///
+/// Replaces the existing entry unless it is from the current search
+/// and was searched deeper for a different position.
+void TranspositionTable::store(const uint64_t hash, const TableEntry& entry)
+{
+    Slot& target = slot(hash);
+    const uint64_t old_data = target.data.load(std::memory_order_relaxed);
+    const uint64_t old_key = target.key.load(std::memory_order_relaxed);
+    if (old_data != 0 && (old_key ^ old_data) != hash) {
+        const auto old_generation = static_cast<uint8_t>(old_data >> GENERATION_SHIFT);
+        const auto old_depth = static_cast<uint8_t>(old_data >> DEPTH_SHIFT);
+        if (old_generation == generation && old_depth > entry.depth) {
+            return;
+        }
+    }
+    const uint64_t data = pack(entry, generation);
+    target.data.store(data, std::memory_order_relaxed);
+    target.key.store(hash ^ data, std::memory_order_relaxed);
+}
+
+/// Mark existing entries as stale so that they are replaced first.
+/// Call once before each new search. Not safe to call while searching.
+void TranspositionTable::new_search()
+{
+    generation = generation == 0xFF ? 1 : static_cast<uint8_t>(generation + 1);
+}
+
+/// Remove all entries. Not safe to call while searching.
+void TranspositionTable::clear()
+{
+    for (size_t index = 0; index <= mask; ++index) {
+        slots[index].key.store(0, std::memory_order_relaxed);
+        slots[index].data.store(0, std::memory_order_relaxed);
+    }
+    generation = 1;
+}
+
+/// Returns the number of slots in the table.
+size_t TranspositionTable::size() const
+{
+    return mask + 1;
+}
+
+uint64_t TranspositionTable::pack(const TableEntry& entry, const uint8_t generation)
+{
+    return static_cast<uint64_t>(static_cast<uint16_t>(entry.score))
+        | static_cast<uint64_t>(entry.depth) << DEPTH_SHIFT
+        | static_cast<uint64_t>(entry.bound) << BOUND_SHIFT
+        | static_cast<uint64_t>(entry.best_move) << MOVE_SHIFT
+        | static_cast<uint64_t>(generation) << GENERATION_SHIFT;
+}
+
+TableEntry TranspositionTable::unpack(const uint64_t data)
+{
+    return TableEntry {
+        static_cast<int16_t>(static_cast<uint16_t>(data)),
+        static_cast<uint8_t>(data >> DEPTH_SHIFT),
+        static_cast<Bound>(static_cast<uint8_t>(data >> BOUND_SHIFT)),
+        static_cast<uint8_t>(data >> MOVE_SHIFT),
+    };
+}
+
+TranspositionTable::Slot& TranspositionTable::slot(const uint64_t hash) const
+{
+    return slots[hash & mask];
+}
+
+}  // namespace othello
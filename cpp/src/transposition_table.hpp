@@ -0,0 +1,76 @@
+//==========================================================
+// Transposition table header
+// Shared lock-free cache of searched positions
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <memory>   // std::unique_ptr
+#include <optional>
+
+namespace othello
+{
+/// How a stored score relates to the true score of the position.
+enum class Bound : uint8_t {
+    /// Score is exact
+    exact,
+    /// Search failed high, true score is at least the stored score
+    lower,
+    /// Search failed low, true score is at most the stored score
+    upper,
+};
+
+/// Search result stored for one position.
+struct TableEntry {
+    /// Board index of the best move, or `NO_MOVE`
+    static constexpr uint8_t NO_MOVE = 0xFF;
+
+    int16_t score {0};
+    uint8_t depth {0};
+    Bound bound {Bound::exact};
+    uint8_t best_move {NO_MOVE};
+
+    bool operator==(const TableEntry& other) const = default;
+};
+
+/// Fixed-size hash table of search results keyed by the Zobrist hash of the position.
+///
+/// Each slot is two 64-bit atomic words: the packed entry and the hash XORed with it.
+/// Reads and writes use relaxed atomics without locks, so any number of search threads can share
+/// one table. A slot torn by concurrent writers no longer verifies against its hash,
+/// so a lookup can miss but never returns data for another position.
+class TranspositionTable
+{
+public:
+    /// Allocate a table using roughly the given number of megabytes.
+    /// The slot count is rounded down to a power of two.
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    [[nodiscard]] std::optional<TableEntry> probe(uint64_t hash) const;
+    void store(uint64_t hash, const TableEntry& entry);
+    void new_search();
+    void clear();
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> key {0};
+        std::atomic<uint64_t> data {0};
+    };
+    static_assert(sizeof(Slot) == 16);
+
+    [[nodiscard]] static uint64_t pack(const TableEntry& entry, uint8_t generation);
+    [[nodiscard]] static TableEntry unpack(uint64_t data);
+    [[nodiscard]] Slot& slot(uint64_t hash) const;
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask {0};
+    uint8_t generation {1};
+};
+
+}  // namespace othello
@@ -10,34 +10,81 @@
 #include <openssl/evp.h>
 
 #include <array>
-#include <iomanip>
-#include <sstream>
+#include <stdexcept>
 #include <string>
 
 namespace othello
 {
+namespace
+{
+/// Two hex digits for each byte value.
+constexpr auto HEX_TABLE = [] {
+    constexpr std::string_view digits = "0123456789abcdef";
+    std::array<std::array<char, 2>, 256> table {};
+    for (size_t byte = 0; byte < table.size(); ++byte) {
+        table[byte] = {digits[byte >> 4], digits[byte & 0xF]};
+    }
+    return table;
+}();
+}  // namespace
+
 /// Calculate SHA256 hash for the given string.
 std::string calculate_sha256(const std::string& text)
 {
-    // Code adapted from:
-    // https://stackoverflow.com/questions/2262386/generate-sha256-with-openssl-and-c
-    std::stringstream stream;
-    if (EVP_MD_CTX* context = EVP_MD_CTX_new(); context != nullptr) {
-        if (EVP_DigestInit_ex(context, EVP_sha256(), nullptr) != 0) {
-            if (EVP_DigestUpdate(context, text.c_str(), text.length()) != 0) {
-                std::array<unsigned char, EVP_MAX_MD_SIZE> hash {};
-                unsigned int hash_length = 0;
-                if (EVP_DigestFinal_ex(context, hash.data(), &hash_length) != 0) {
-                    for (unsigned int i = 0; i < hash_length; ++i) {
-                        stream << std::hex << std::setw(2) << std::setfill('0')
-                               << static_cast<int>(hash[i]);
-                    }
-                }
-            }
-        }
-        EVP_MD_CTX_free(context);
+    Sha256 hash;
+    hash.update(text);
+    return hash.hex_digest();
+}
+
+/// Lowercase hex string of the given bytes.
+std::string to_hex(const std::span<const unsigned char> bytes)
+{
+    std::string hex(bytes.size() * 2, '0');
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        const auto& digits = HEX_TABLE[bytes[i]];
+        hex[2 * i] = digits[0];
+        hex[2 * i + 1] = digits[1];
+    }
+    return hex;
+}
+
+Sha256::Sha256() : context(EVP_MD_CTX_new())
+{
+    if (context == nullptr) {
+        throw std::runtime_error("Failed to create SHA256 context");
+    }
+    reset();
+}
+
+void Sha256::update(const std::string_view text)
+{
+    if (EVP_DigestUpdate(context.get(), text.data(), text.size()) == 0) {
+        throw std::runtime_error("Failed to update SHA256 hash");
+    }
+}
+
+std::string Sha256::hex_digest() const
+{
+    // Finalise a copy so the running hash can continue
+    const std::unique_ptr<EVP_MD_CTX, ContextDeleter> copy(EVP_MD_CTX_new());
+    std::array<unsigned char, EVP_MAX_MD_SIZE> hash {};
+    unsigned int hash_length = 0;
+    if (copy == nullptr || EVP_MD_CTX_copy_ex(copy.get(), context.get()) == 0
+        || EVP_DigestFinal_ex(copy.get(), hash.data(), &hash_length) == 0) {
+        throw std::runtime_error("Failed to finalise SHA256 hash");
     }
+    return to_hex(std::span(hash.data(), hash_length));
+}
+
+void Sha256::reset()
+{
+    if (EVP_DigestInit_ex(context.get(), EVP_sha256(), nullptr) == 0) {
+        throw std::runtime_error("Failed to initialise SHA256 hash");
+    }
+}
 
-    return stream.str();
+void Sha256::ContextDeleter::operator()(evp_md_ctx_st* context) const
+{
+    EVP_MD_CTX_free(context);
 }
 }  // namespace othello
@@ -9,9 +9,16 @@
 #include "colorprint.hpp"
 
 #include <concepts>
+#include <cstdint>   // uint64_t
 #include <iostream>  // cout, cin
-#include <sstream>   // stringstream
-#include <string>    // string
+#include <memory>    // unique_ptr
+#include <span>
+#include <sstream>  // stringstream
+#include <string>   // string
+#include <string_view>
+
+// OpenSSL digest context, only used through a pointer here
+struct evp_md_ctx_st;
 
 // Concept: checks if T can be streamed into std::ostream
 template<typename T>
@@ -24,6 +31,35 @@ namespace othello
 /// Calculate SHA256 hash for the given string.
 std::string calculate_sha256(const std::string& text);
 
+/// Lowercase hex string of the given bytes.
+std::string to_hex(std::span<const unsigned char> bytes);
+
+/// Incremental SHA256 hash.
+///
+/// Text can be added piece by piece as it is produced,
+/// and the digest is the same as for the concatenated text in one go.
+class Sha256
+{
+public:
+    Sha256();
+
+    /// Add text to the hashed data.
+    void update(std::string_view text);
+
+    /// Hex digest of all the text added so far. More text can still be added afterwards.
+    [[nodiscard]] std::string hex_digest() const;
+
+    /// Start over with no hashed data.
+    void reset();
+
+private:
+    struct ContextDeleter {
+        void operator()(evp_md_ctx_st* context) const;
+    };
+
+    std::unique_ptr<evp_md_ctx_st, ContextDeleter> context;
+};
+
 /// Print an object to stream (default is std::cout).
 ///
 /// Requires that the stream insertion operator `<<` has been implemented for the given object.
@@ -48,6 +84,43 @@ std::string to_string(const T& object)
     return stream.str();
 }
 
+/// Advance a SplitMix64 generator state and return the next pseudo-random value.
+///
+/// Cheap, deterministic and usable at compile time.
+/// https://prng.di.unimi.it/splitmix64.c
+[[nodiscard]] constexpr uint64_t splitmix64(uint64_t& state)
+{
+    state += 0x9E3779B97F4A7C15;
+    uint64_t value = state;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+    return value ^ (value >> 31);
+}
+
+/// Small and fast pseudo-random generator for hot loops like random playouts.
+///
+/// Each thread should own one, seeded differently. Not suitable for cryptography.
+class FastRandom
+{
+public:
+    explicit constexpr FastRandom(const uint64_t seed) : state(seed) {}
+
+    /// Next 64-bit pseudo-random value.
+    constexpr uint64_t next()
+    {
+        return splitmix64(state);
+    }
+
+    /// Pseudo-random value in range [0, bound). Bound must be below 2^32.
+    constexpr uint64_t below(const uint64_t bound)
+    {
+        return ((next() >> 32) * bound) >> 32;
+    }
+
+private:
+    uint64_t state;
+};
+
 /// Remove leading and trailing whitespace from the given string.
 [[nodiscard]] inline std::string trim(const std::string& text)
 {
@@ -0,0 +1,60 @@
+//==========================================================
+// Zobrist header
+// Random keys for hashing board positions
+// Akseli Lukkarila
+// 2019-2026
+//==========================================================
+
+#pragma once
+#include "models.hpp"
+#include "settings.hpp"
+#include "utils.hpp"
+
+#include <array>
+#include <cstdint>  // uint64_t
+
+namespace othello
+{
+/// Random keys for Zobrist hashing of board positions.
+///
+/// A position hash is the XOR of the key of each disk on the board,
+/// plus the side key when white is to move.
+/// Keys are generated at compile time from a fixed seed,
+/// so hashes stay identical across runs and builds and can be stored in files.
+struct ZobristKeys {
+    static constexpr size_t SQUARES = MAX_BOARD_SIZE * MAX_BOARD_SIZE;
+
+    /// Key for the given disk at the given board index. Empty squares have no key.
+    [[nodiscard]] constexpr uint64_t disk(const Disk disk, const size_t index) const
+    {
+        switch (disk) {
+            case Disk::black:
+                return black[index];
+            case Disk::white:
+                return white[index];
+            default:
+                return 0;
+        }
+    }
+
+    std::array<uint64_t, SQUARES> black {};
+    std::array<uint64_t, SQUARES> white {};
+    /// Combined black and white key for flipping a disk from one colour to the other
+    std::array<uint64_t, SQUARES> flip {};
+    /// Included in the hash when white is to move
+    uint64_t white_to_move {0};
+};
+
+inline constexpr ZobristKeys ZOBRIST = [] {
+    ZobristKeys keys;
+    uint64_t state = 0x07E110;
+    for (size_t index = 0; index < ZobristKeys::SQUARES; ++index) {
+        keys.black[index] = splitmix64(state);
+        keys.white[index] = splitmix64(state);
+        keys.flip[index] = keys.black[index] ^ keys.white[index];
+    }
+    keys.white_to_move = splitmix64(state);
+    return keys;
+}();
+
+}  // namespace othello
@@ -0,0 +1,177 @@
+#include "board.hpp"
+#include "game_record.hpp"
+#include "othello.hpp"
+#include "utils.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>  // int64_t
+#include <optional>
+#include <random>
+#include <string>
+
+namespace othello
+{
+/// Benchmark access to the private members of `Othello`.
+class OthelloBenchmark
+{
+public:
+    /// Game with the given moves, as if they had been played.
+    static Othello game(const GameRecord& record)
+    {
+        Othello game(Settings(record.board_size, true, true, false, false, true, false));
+        game.game_record = record;
+        return game;
+    }
+
+    static std::string format_game_log(const Othello& game)
+    {
+        return game.format_game_log();
+    }
+};
+
+namespace
+{
+/// Game phase as the share of the starting empty squares still left empty.
+enum class Phase { opening, midgame, endgame };
+
+constexpr std::array<size_t, 3> PHASE_EMPTY_PERCENT {90, 50, 15};
+
+/// Position reached by random play, with the moves up to that point.
+struct GamePosition {
+    Board board;
+    Disk disk;
+    GameRecord record;
+};
+
+/// Play seeded random games on the given board size until one reaches the game phase.
+GamePosition game_position(const size_t size, const Phase phase)
+{
+    const size_t start_empties = Board(size).empty_count();
+    const size_t empties = start_empties * PHASE_EMPTY_PERCENT[static_cast<size_t>(phase)] / 100;
+    for (unsigned seed = 0;; ++seed) {
+        std::mt19937 random(seed);
+        GamePosition position {Board(size), Disk::black, {size, seed, {}}};
+        bool passed = false;
+        while (position.board.empty_count() > empties) {
+            const auto moves = position.board.possible_moves(position.disk);
+            if (moves.empty()) {
+                if (passed) {
+                    break;
+                }
+                passed = true;
+                position.board.pass();
+                position.record.add({position.disk, std::nullopt});
+                position.disk = opponent(position.disk);
+                continue;
+            }
+            passed = false;
+            std::uniform_int_distribution<size_t> pick(0, moves.size() - 1);
+            const auto& move = moves[pick(random)];
+            position.board.place_disk(move);
+            position.record.add({position.disk, move});
+            position.disk = opponent(position.disk);
+        }
+        if (position.board.empty_count() <= empties
+            && !position.board.possible_moves(position.disk).empty()) {
+            return position;
+        }
+    }
+}
+
+GamePosition game_position(const benchmark::State& state)
+{
+    return game_position(
+        static_cast<size_t>(state.range(0)), static_cast<Phase>(state.range(1))
+    );
+}
+
+/// Every board size with every game phase.
+void board_sizes_and_phases(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"size", "phase"});
+    benchmark->ArgsProduct({
+        benchmark::CreateDenseRange(MIN_BOARD_SIZE, MAX_BOARD_SIZE, 1),
+        {static_cast<int64_t>(Phase::opening),
+         static_cast<int64_t>(Phase::midgame),
+         static_cast<int64_t>(Phase::endgame)},
+    });
+}
+
+void possible_moves(benchmark::State& state)
+{
+    const auto position = game_position(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(position.board.possible_moves(position.disk));
+    }
+}
+
+/// Play each legal move in turn.
+/// Restoring the board by assignment is included, it reuses the existing storage.
+void place_disk(benchmark::State& state)
+{
+    const auto position = game_position(state);
+    const auto moves = position.board.possible_moves(position.disk);
+    Board board = position.board;
+    size_t index = 0;
+    for (auto _ : state) {
+        board = position.board;
+        board.place_disk(moves[index]);
+        benchmark::ClobberMemory();
+        index = index + 1 < moves.size() ? index + 1 : 0;
+    }
+}
+
+void affected_squares(benchmark::State& state)
+{
+    const auto position = game_position(state);
+    const auto moves = position.board.possible_moves(position.disk);
+    for (auto _ : state) {
+        for (const auto& move : moves) {
+            benchmark::DoNotOptimize(move.affected_squares());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(moves.size()));
+}
+
+void log_entry(benchmark::State& state)
+{
+    const auto position = game_position(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(position.board.log_entry());
+    }
+}
+
+void sha256(benchmark::State& state)
+{
+    const auto position = game_position(state);
+    const auto game = OthelloBenchmark::game(position.record);
+    const auto formatted_log = OthelloBenchmark::format_game_log(game);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calculate_sha256(formatted_log));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(formatted_log.size()));
+}
+
+void format_game_log(benchmark::State& state)
+{
+    const auto position = game_position(state);
+    const auto game = OthelloBenchmark::game(position.record);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(OthelloBenchmark::format_game_log(game));
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<int64_t>(position.record.turns.size())
+    );
+}
+
+BENCHMARK(possible_moves)->Apply(board_sizes_and_phases);
+BENCHMARK(place_disk)->Apply(board_sizes_and_phases);
+BENCHMARK(affected_squares)->Apply(board_sizes_and_phases);
+BENCHMARK(log_entry)->Apply(board_sizes_and_phases);
+BENCHMARK(sha256)->Apply(board_sizes_and_phases);
+BENCHMARK(format_game_log)->Apply(board_sizes_and_phases);
+}  // namespace
+
+}  // namespace othello
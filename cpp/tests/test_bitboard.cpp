@@ -0,0 +1,95 @@
+#include "bitboard.hpp"
+
+#include <gtest/gtest.h>
+
+namespace othello
+{
+
+TEST(bitboard, full_mask)
+{
+    EXPECT_EQ(BoardGeometry<4>::FULL, Bitboard64 {0xFFFF});
+    EXPECT_EQ(BoardGeometry<8>::FULL, ~Bitboard64 {0});
+    EXPECT_EQ(count(BoardGeometry<9>::FULL), 81);
+    EXPECT_EQ(count(BoardGeometry<10>::FULL), 100);
+}
+
+TEST(bitboard, bit_indices)
+{
+    EXPECT_EQ(lowest_index(square_bit<Bitboard128>(70)), 70);
+    EXPECT_EQ(highest_index(square_bit<Bitboard128>(70) | square_bit<Bitboard128>(3)), 70);
+    EXPECT_EQ(highest_index(square_bit<Bitboard64>(5) | square_bit<Bitboard64>(3)), 5);
+    Bitboard128 bits = square_bit<Bitboard128>(63) | square_bit<Bitboard128>(64);
+    EXPECT_EQ(pop_lowest(bits), 63);
+    EXPECT_EQ(pop_lowest(bits), 64);
+    EXPECT_FALSE(any(bits));
+}
+
+TEST(bitboard, shift_does_not_wrap)
+{
+    using Geometry = BoardGeometry<4>;
+    // Step right from the last column leaves the board
+    EXPECT_EQ(Geometry::shift<7>(square_bit<Bitboard64>(3)), Bitboard64 {0});
+    // Step left from the first column leaves the board
+    EXPECT_EQ(Geometry::shift<2>(square_bit<Bitboard64>(4)), Bitboard64 {0});
+    // Step down and right from the middle
+    EXPECT_EQ(Geometry::shift<6>(square_bit<Bitboard64>(5)), square_bit<Bitboard64>(10));
+}
+
+TEST(bitboard, shift_across_words)
+{
+    using Geometry = BoardGeometry<10>;
+    // Step down from row 6 moves bit 63 over to the high word
+    EXPECT_EQ(Geometry::shift<4>(square_bit<Bitboard128>(63)), square_bit<Bitboard128>(73));
+    // Step up moves it back
+    EXPECT_EQ(Geometry::shift<3>(square_bit<Bitboard128>(73)), square_bit<Bitboard128>(63));
+    // Step down from the last row leaves the board
+    EXPECT_FALSE(any(Geometry::shift<4>(square_bit<Bitboard128>(95))));
+}
+
+TEST(bitboard, rays)
+{
+    using Geometry = BoardGeometry<4>;
+    // Right from the top left corner
+    EXPECT_EQ(Geometry::RAYS[0][7], Bitboard64 {0b1110});
+    // Up from the top left corner
+    EXPECT_EQ(Geometry::RAYS[0][3], Bitboard64 {0});
+    EXPECT_EQ(Geometry::INDEX_SQUARES[6], Square(2, 1));
+}
+
+TEST(bitboard, legal_moves_start_position)
+{
+    using Geometry = BoardGeometry<8>;
+    const Bitboard64 white = square_bit<Bitboard64>(27) | square_bit<Bitboard64>(36);
+    const Bitboard64 black = square_bit<Bitboard64>(28) | square_bit<Bitboard64>(35);
+    const Bitboard64 moves = Geometry::legal_moves(black, white);
+    EXPECT_EQ(
+        moves,
+        square_bit<Bitboard64>(19) | square_bit<Bitboard64>(26) | square_bit<Bitboard64>(37)
+            | square_bit<Bitboard64>(44)
+    );
+    EXPECT_EQ(Geometry::flips(black, white, 19), square_bit<Bitboard64>(27));
+}
+
+TEST(bitboard, legal_moves_start_position_10x10)
+{
+    using Geometry = BoardGeometry<10>;
+    const Bitboard128 white = square_bit<Bitboard128>(44) | square_bit<Bitboard128>(55);
+    const Bitboard128 black = square_bit<Bitboard128>(45) | square_bit<Bitboard128>(54);
+    const Bitboard128 moves = Geometry::legal_moves(black, white);
+    EXPECT_EQ(count(moves), 4);
+    EXPECT_EQ(Geometry::flips(black, white, 65), square_bit<Bitboard128>(55));
+}
+
+TEST(bitboard, flips_multiple_directions)
+{
+    using Geometry = BoardGeometry<8>;
+    const Bitboard64 black = square_bit<Bitboard64>(0) | square_bit<Bitboard64>(4);
+    const Bitboard64 white = square_bit<Bitboard64>(1) | square_bit<Bitboard64>(2)
+        | square_bit<Bitboard64>(3) | square_bit<Bitboard64>(9);
+    // Placing at index 18 (2,2) flips the diagonal (1,1) towards (0,0)
+    EXPECT_EQ(Geometry::flips(black, white, 18), square_bit<Bitboard64>(9));
+    // Placing at index 4 flips the white line back towards (0,0)
+    EXPECT_EQ(Geometry::flips(square_bit<Bitboard64>(0), white, 4), Bitboard64 {0b1110});
+}
+
+}  // namespace othello
@@ -88,4 +88,130 @@ TEST_F(BoardTest, log_entry)
     EXPECT_EQ(board4.log_entry(), "____BBB__BW_____");
 }
 
+TEST_F(BoardTest, unsupported_size)
+{
+    EXPECT_THROW(Board(MIN_BOARD_SIZE - 1), std::invalid_argument);
+    EXPECT_THROW(Board(MAX_BOARD_SIZE + 1), std::invalid_argument);
+}
+
+TEST_F(BoardTest, sized_board)
+{
+    SizedBoard<4> board;
+    EXPECT_EQ(board.get(5), Disk::white);
+    EXPECT_EQ(board.get(6), Disk::black);
+    EXPECT_EQ(count(board.legal_moves(Disk::black)), 4);
+    EXPECT_EQ(board.score(), 0);
+
+    const auto flipped = board.place(Disk::black, 4);
+    EXPECT_EQ(flipped, square_bit<Bitboard64>(5));
+    EXPECT_EQ(board.score(), -3);
+    EXPECT_EQ(SizedBoard<4>::index_square(4), Square(0, 1));
+    EXPECT_EQ(SizedBoard<4>::square_index(Square(0, 1)), 4);
+}
+
+TEST_F(BoardTest, make_and_unmake_move)
+{
+    Board board(8);
+    const auto start = board.log_entry();
+    const auto moves = board.possible_moves(Disk::black);
+    const auto undo = board.make_move(moves[0]);
+    EXPECT_NE(board.log_entry(), start);
+    EXPECT_EQ(count(undo.flipped), moves[0].value);
+
+    const auto replies = board.possible_moves(Disk::white);
+    const auto reply_undo = board.make_move(replies[0]);
+    board.unmake_move(reply_undo);
+    board.unmake_move(undo);
+    EXPECT_EQ(board.log_entry(), start);
+}
+
+TEST_F(BoardTest, scoped_move)
+{
+    SizedBoard<10> board;
+    const SizedBoard<10> start = board;
+    const size_t index = lowest_index(board.legal_moves(Disk::black));
+    {
+        const ScopedMove guard(board, Disk::black, index);
+        EXPECT_EQ(board.get(index), Disk::black);
+        EXPECT_EQ(count(guard.record().flipped), 1);
+        EXPECT_NE(board, start);
+    }
+    EXPECT_EQ(board, start);
+}
+
+TEST_F(BoardTest, visit_sized_board)
+{
+    const Board board(10);
+    const size_t size = board.visit([](const auto& sized) { return sized.SIZE; });
+    EXPECT_EQ(size, 10);
+}
+
+TEST_F(BoardTest, hash_incremental)
+{
+    SizedBoard<8> board;
+    const uint64_t start = board.hash();
+    EXPECT_EQ(
+        start,
+        SizedBoard<8>::compute_hash(
+            board.disks(Disk::black), board.disks(Disk::white), Disk::black
+        )
+    );
+    const auto undo = board.make_move(Disk::black, lowest_index(board.legal_moves(Disk::black)));
+    EXPECT_NE(board.hash(), start);
+    EXPECT_EQ(board.side_to_move(), Disk::white);
+    EXPECT_EQ(
+        board.hash(),
+        SizedBoard<8>::compute_hash(
+            board.disks(Disk::black), board.disks(Disk::white), Disk::white
+        )
+    );
+    board.unmake_move(undo);
+    EXPECT_EQ(board.hash(), start);
+    EXPECT_EQ(board.side_to_move(), Disk::black);
+}
+
+TEST_F(BoardTest, hash_side_to_move)
+{
+    Board board(8);
+    const uint64_t start = board.hash();
+    board.pass();
+    EXPECT_EQ(board.side_to_move(), Disk::white);
+    EXPECT_NE(board.hash(), start);
+    board.pass();
+    EXPECT_EQ(board.hash(), start);
+}
+
+TEST_F(BoardTest, hash_set_square)
+{
+    // Same disks set in a different order give the same hash as the start position
+    SizedBoard<8> board(0, 0);
+    board.set(36, Disk::black);
+    board.set(28, Disk::white);
+    board.set(35, Disk::black);
+    board.set(27, Disk::white);
+    board.set(36, Disk::white);
+    board.set(28, Disk::black);
+    EXPECT_EQ(board.hash(), SizedBoard<8>().hash());
+    EXPECT_EQ(board, SizedBoard<8>());
+}
+
+TEST_F(BoardTest, from_position)
+{
+    const Board board = Board::from_position("W:____BBB__BW_____");
+    EXPECT_EQ(board.log_entry(), "____BBB__BW_____");
+    EXPECT_EQ(board.side_to_move(), Disk::white);
+    const uint64_t expected = board.visit([](const auto& sized) {
+        return sized.compute_hash(sized.disks(Disk::black), sized.disks(Disk::white), Disk::white);
+    });
+    EXPECT_EQ(board.hash(), expected);
+    EXPECT_EQ(Board::from_position("B:" + Board(8).log_entry()).hash(), Board(8).hash());
+    EXPECT_EQ(board.position(), "W:____BBB__BW_____");
+    EXPECT_EQ(Board(6).position(), "B:______________WB____BW______________");
+
+    // Missing side, wrong length and unknown square
+    for (const auto* position : {"____BBB__BW_____", "B:____BBB__BW____", "B:____BBB__BX____"}) {
+        EXPECT_THROW(static_cast<void>(Board::from_position(position)), std::invalid_argument);
+    }
+}
+
 }  // namespace othello
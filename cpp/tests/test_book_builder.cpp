@@ -0,0 +1,119 @@
+#include "book_builder.hpp"
+#include "search.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::ranges::sort
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace othello
+{
+class BookBuilderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const auto seed = ::testing::UnitTest::GetInstance()->random_seed();
+        output = std::filesystem::temp_directory_path()
+            / ("othello_builder_test_" + std::to_string(seed) + ".book");
+        settings.board_size = 4;
+        settings.depth = 12;
+        settings.plies = 12;
+        settings.drop_out = 1000;
+        settings.threads = 2;
+        settings.output = output;
+        settings.verbose = false;
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(output);
+        std::filesystem::remove(checkpoint());
+    }
+
+    [[nodiscard]] std::filesystem::path checkpoint() const
+    {
+        auto path = output;
+        path += ".checkpoint";
+        return path;
+    }
+
+    static std::vector<BookRecord> sorted(std::vector<BookRecord> records)
+    {
+        std::ranges::sort(records, {}, &BookRecord::key);
+        return records;
+    }
+
+    std::filesystem::path output;
+    BookSettings settings;
+};
+
+TEST(book_builder, play_book_move)
+{
+    Board board(4);
+    // Black plays (1,0) on the 4x4 start position
+    EXPECT_TRUE(play_book_move(board, 1));
+    EXPECT_EQ(board.side_to_move(), Disk::white);
+    EXPECT_THROW(static_cast<void>(play_book_move(board, 3)), std::runtime_error);
+
+    // Black fills the last square, so the game is over
+    Board last = Board::from_position("B:BWWWWWWWWWWWWWW_");
+    EXPECT_FALSE(play_book_move(last, 15));
+}
+
+TEST_F(BookBuilderTest, backed_up_scores_are_exact)
+{
+    // Searching every move to the end gives the exact result of the game
+    BookBuilder builder(settings);
+    builder.build();
+    const OpeningBook book(output);
+    EXPECT_EQ(book.size(), builder.size());
+
+    const Board start(4);
+    const auto found = book.lookup(start, Disk::black);
+    ASSERT_TRUE(found.has_value());
+    TranspositionTable table;
+    const auto result = search(start, Disk::black, SearchLimits {12, std::nullopt, 1}, table);
+    EXPECT_EQ(found->score, result.score);
+
+    // Duplicate transpositions are merged, so every position has its own record
+    for (const auto& record : builder.records()) {
+        EXPECT_TRUE(book.find(record.key).has_value());
+    }
+}
+
+TEST_F(BookBuilderTest, drop_out_limits_the_tree)
+{
+    BookBuilder full(settings);
+    full.build();
+    std::filesystem::remove(checkpoint());
+    settings.drop_out = 0;
+    BookBuilder best_lines(settings);
+    best_lines.build();
+    EXPECT_GT(best_lines.size(), 0);
+    EXPECT_LT(best_lines.size(), full.size());
+}
+
+TEST_F(BookBuilderTest, resume_from_checkpoint)
+{
+    settings.depth = 4;
+    settings.plies = 6;
+    BookBuilder builder(settings);
+    builder.build();
+    const auto expected = sorted(builder.records());
+
+    // Cut the last position short as if the build was interrupted while writing it
+    const auto size = std::filesystem::file_size(checkpoint());
+    std::filesystem::resize_file(checkpoint(), size - 3);
+    BookBuilder resumed(settings);
+    resumed.build();
+    EXPECT_EQ(sorted(resumed.records()), expected);
+
+    // Checkpoint for another board size is rejected
+    settings.board_size = 6;
+    EXPECT_THROW(BookBuilder(settings).build(), std::runtime_error);
+}
+
+}  // namespace othello
@@ -0,0 +1,166 @@
+#include "endgame.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::max
+#include <chrono>
+#include <random>
+
+namespace othello
+{
+/// Plain minimax of the final disk difference to check the solver against.
+template<size_t N>
+int brute_force(SizedBoard<N>& board, const Disk disk, const bool passed)
+{
+    auto legal = board.legal_moves(disk);
+    if (!any(legal)) {
+        if (passed) {
+            return static_cast<int>(board.count(disk))
+                - static_cast<int>(board.count(opponent(disk)));
+        }
+        return -brute_force(board, opponent(disk), true);
+    }
+    int best = -1000;
+    while (any(legal)) {
+        const ScopedMove guard(board, disk, pop_lowest(legal));
+        best = std::max(best, -brute_force(board, opponent(disk), false));
+    }
+    return best;
+}
+
+/// Play random moves from the start until the given number of squares is left empty.
+template<size_t N>
+Board random_position(const size_t empties, const unsigned seed, Disk& to_move)
+{
+    std::mt19937 random(seed);
+    Board board(N);
+    to_move = Disk::black;
+    while (board.empty_count() > empties) {
+        auto moves = board.possible_moves(to_move);
+        if (moves.empty()) {
+            to_move = opponent(to_move);
+            moves = board.possible_moves(to_move);
+            if (moves.empty()) {
+                break;
+            }
+        }
+        std::uniform_int_distribution<size_t> pick(0, moves.size() - 1);
+        board.place_disk(moves[pick(random)]);
+        to_move = opponent(to_move);
+    }
+    return board;
+}
+
+TEST(endgame, solves_small_board)
+{
+    const Board board(4);
+    TranspositionTable table(1);
+    const auto result = solve_endgame(board, Disk::black, table);
+    SizedBoard<4> sized;
+    EXPECT_EQ(result.score, brute_force(sized, Disk::black, false));
+    ASSERT_TRUE(result.best_move.has_value());
+}
+
+TEST(endgame, matches_brute_force)
+{
+    TranspositionTable table(1);
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        Disk disk;
+        const Board board = random_position<8>(9, seed, disk);
+        const auto result = solve_endgame(board, disk, table);
+        auto sized = board.visit([](const auto& inner) {
+            return SizedBoard<8>(
+                narrow<Bitboard64>(widen(inner.disks(Disk::black))),
+                narrow<Bitboard64>(widen(inner.disks(Disk::white)))
+            );
+        });
+        EXPECT_EQ(result.score, brute_force(sized, disk, false)) << "seed " << seed;
+    }
+}
+
+TEST(endgame, matches_brute_force_large_board)
+{
+    TranspositionTable table(1);
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        Disk disk;
+        const Board board = random_position<10>(8, seed, disk);
+        const auto result = solve_endgame(board, disk, table);
+        auto sized = board.visit([](const auto& inner) {
+            return SizedBoard<10>(
+                narrow<Bitboard128>(widen(inner.disks(Disk::black))),
+                narrow<Bitboard128>(widen(inner.disks(Disk::white)))
+            );
+        });
+        EXPECT_EQ(result.score, brute_force(sized, disk, false)) << "seed " << seed;
+    }
+}
+
+TEST(endgame, best_move_reaches_score)
+{
+    TranspositionTable table(1);
+    Disk disk;
+    Board board = random_position<8>(12, 7, disk);
+    const auto result = solve_endgame(board, disk, table);
+    ASSERT_TRUE(result.best_move.has_value());
+    const auto moves = board.possible_moves(disk);
+    const auto found = std::ranges::find_if(moves, [&](const Move& move) {
+        return move.square == result.best_move;
+    });
+    ASSERT_NE(found, moves.end());
+    board.place_disk(*found);
+    // Opponent's best result after the chosen move is the negated score
+    const auto reply = solve_endgame(board, opponent(disk), table);
+    EXPECT_EQ(reply.score, -result.score);
+}
+
+TEST(endgame, time_limit)
+{
+    TranspositionTable table(1);
+    Disk disk;
+    const Board board = random_position<8>(12, 7, disk);
+    const auto exact = solve_endgame(board, disk, table);
+    table.clear();
+    const auto timed = solve_endgame(board, disk, table, std::chrono::seconds(60));
+    EXPECT_TRUE(timed.complete);
+    EXPECT_EQ(timed.score, exact.score);
+
+    // The whole game from the start cannot be solved in time
+    const auto start = std::chrono::steady_clock::now();
+    const auto stopped
+        = solve_endgame(Board(8), Disk::black, table, std::chrono::milliseconds {20});
+    EXPECT_FALSE(stopped.complete);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+}
+
+TEST(endgame, win_loss_draw)
+{
+    TranspositionTable table(1);
+    uint64_t exact_nodes = 0;
+    uint64_t wld_nodes = 0;
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        Disk disk;
+        const Board board = random_position<8>(14, seed, disk);
+        table.clear();
+        const auto exact = solve_endgame(board, disk, table);
+        table.clear();
+        const auto wld = solve_win_loss_draw(board, disk, table);
+        const int sign = exact.score > 0 ? 1 : exact.score < 0 ? -1 : 0;
+        EXPECT_EQ(wld.score, sign) << "seed " << seed;
+        exact_nodes += exact.nodes;
+        wld_nodes += wld.nodes;
+    }
+    EXPECT_LT(wld_nodes, exact_nodes);
+}
+
+TEST(endgame, win_loss_draw_position)
+{
+    TranspositionTable table(1);
+    // Black has no disks left so neither side can move
+    const Board board = Board::from_position("B:WWWWWWWWWWWWWWW_");
+    const auto exact = solve_endgame(board, Disk::black, table);
+    EXPECT_FALSE(exact.best_move.has_value());
+    EXPECT_EQ(exact.score, -15);
+    EXPECT_EQ(solve_win_loss_draw(board, Disk::black, table).score, -1);
+}
+
+}  // namespace othello
@@ -0,0 +1,144 @@
+#include "board.hpp"
+#include "evaluation.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <utility>  // std::index_sequence
+#include <vector>
+
+namespace othello
+{
+/// Play random games and check that the incremental pattern indices
+/// match the indices computed from scratch after every move and every take back.
+template<size_t N>
+void check_incremental_patterns(const unsigned seed)
+{
+    std::mt19937 random(seed);
+    SizedBoard<N> board;
+    PatternFeatures<N> patterns(board);
+    std::vector<typename SizedBoard<N>::Undo> history;
+    Disk disk = Disk::black;
+    while (true) {
+        auto legal = board.legal_moves(disk);
+        if (!any(legal)) {
+            disk = opponent(disk);
+            legal = board.legal_moves(disk);
+            if (!any(legal)) {
+                break;
+            }
+        }
+        std::uniform_int_distribution<size_t> pick(0, count(legal) - 1);
+        for (size_t skip = pick(random); skip > 0; --skip) {
+            pop_lowest(legal);
+        }
+        history.push_back(board.make_move(disk, lowest_index(legal)));
+        patterns.apply(history.back());
+        ASSERT_EQ(patterns, PatternFeatures<N>(board)) << "size " << N;
+        disk = opponent(disk);
+    }
+    while (!history.empty()) {
+        board.unmake_move(history.back());
+        patterns.revert(history.back());
+        history.pop_back();
+        ASSERT_EQ(patterns, PatternFeatures<N>(board)) << "size " << N;
+    }
+    EXPECT_EQ(patterns, PatternFeatures<N>(SizedBoard<N> {}));
+}
+
+template<size_t... Offsets>
+void check_incremental_patterns_all_sizes(std::index_sequence<Offsets...>)
+{
+    for (const unsigned seed : {1U, 2U, 3U}) {
+        (check_incremental_patterns<MIN_BOARD_SIZE + Offsets>(seed), ...);
+    }
+}
+
+TEST(evaluation, incremental_patterns)
+{
+    check_incremental_patterns_all_sizes(
+        std::make_index_sequence<MAX_BOARD_SIZE - MIN_BOARD_SIZE + 1> {}
+    );
+}
+
+TEST(evaluation, pattern_squares)
+{
+    using Geometry = PatternGeometry<8>;
+    for (const auto& pattern : Geometry::PATTERNS) {
+        const size_t length = Geometry::LENGTHS[static_cast<size_t>(pattern.shape)];
+        const std::set<uint8_t> squares(pattern.squares.begin(), pattern.squares.begin() + length);
+        EXPECT_EQ(squares.size(), length);
+        EXPECT_LT(*squares.rbegin(), Geometry::SQUARES);
+    }
+    // Corners are in both edges, one diagonal, two corner blocks and one corner square
+    EXPECT_EQ(Geometry::SQUARE_PATTERNS[0].size, 6);
+    EXPECT_EQ(Geometry::SQUARE_PATTERNS[63].size, 6);
+}
+
+TEST(evaluation, colour_and_mirror_symmetry)
+{
+    std::mt19937 random(7);
+    SizedBoard<8> board;
+    Disk disk = Disk::black;
+    for (int move = 0; move < 40; ++move) {
+        auto legal = board.legal_moves(disk);
+        if (!any(legal)) {
+            break;
+        }
+        std::uniform_int_distribution<size_t> pick(0, count(legal) - 1);
+        for (size_t skip = pick(random); skip > 0; --skip) {
+            pop_lowest(legal);
+        }
+        board.place(disk, lowest_index(legal));
+        disk = opponent(disk);
+
+        const SizedBoard<8> swapped(board.disks(Disk::white), board.disks(Disk::black));
+        EXPECT_EQ(evaluate(board, Disk::black), evaluate(swapped, Disk::white));
+
+        SizedBoard<8> mirrored(0, 0);
+        for (size_t index = 0; index < 64; ++index) {
+            mirrored.set(index / 8 * 8 + 7 - index % 8, board.get(index));
+        }
+        EXPECT_EQ(evaluate(board, Disk::black), evaluate(mirrored, Disk::black));
+    }
+}
+
+TEST(evaluation, values_corners_and_stable_edges)
+{
+    // Black holds the top left corner and a run of edge disks from it
+    const auto stable = Board::from_position("B:"
+                                             "BBBB____"
+                                             "________"
+                                             "___WB___"
+                                             "___BW___"
+                                             "________"
+                                             "________"
+                                             "________"
+                                             "________");
+    // Same disks along the edge but without the corner
+    const auto loose = Board::from_position("B:"
+                                            "_BBBB___"
+                                            "________"
+                                            "___WB___"
+                                            "___BW___"
+                                            "________"
+                                            "________"
+                                            "________"
+                                            "________");
+    EXPECT_GT(stable.evaluate(Disk::black), loose.evaluate(Disk::black));
+    EXPECT_LT(stable.evaluate(Disk::white), 0);
+    // Giving away the corner with an X-square is bad
+    const auto x_square = Board::from_position("B:"
+                                               "________"
+                                               "_B______"
+                                               "___WB___"
+                                               "___BW___"
+                                               "________"
+                                               "________"
+                                               "________"
+                                               "________");
+    EXPECT_LT(x_square.evaluate(Disk::black), 0);
+}
+
+}  // namespace othello
@@ -0,0 +1,174 @@
+#include "board.hpp"
+#include "features.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <type_traits>  // std::remove_cvref_t
+#include <vector>
+
+namespace othello
+{
+/// Play random moves from the start until the given number of squares is left empty.
+template<size_t N>
+SizedBoard<N> random_sized_position(const size_t empties, const unsigned seed)
+{
+    std::mt19937 random(seed);
+    SizedBoard<N> board;
+    Disk disk = Disk::black;
+    while (count(board.empty()) > empties) {
+        auto legal = board.legal_moves(disk);
+        if (!any(legal)) {
+            disk = opponent(disk);
+            legal = board.legal_moves(disk);
+            if (!any(legal)) {
+                break;
+            }
+        }
+        std::uniform_int_distribution<size_t> pick(0, count(legal) - 1);
+        for (size_t skip = pick(random); skip > 0; --skip) {
+            pop_lowest(legal);
+        }
+        board.place(disk, lowest_index(legal));
+        disk = opponent(disk);
+    }
+    return board;
+}
+
+/// Squares next to the given square.
+template<size_t N>
+std::vector<size_t> adjacent(const size_t index)
+{
+    std::vector<size_t> squares;
+    const int x = static_cast<int>(index % N);
+    const int y = static_cast<int>(index / N);
+    for (const auto& [step_x, step_y] : STEP_DIRECTIONS) {
+        if (BoardGeometry<N>::check_coordinates(x + step_x, y + step_y)) {
+            squares.push_back(static_cast<size_t>((y + step_y) * static_cast<int>(N) + x + step_x));
+        }
+    }
+    return squares;
+}
+
+/// Play every possible continuation and clear the stable disks that get flipped.
+template<size_t N>
+void remove_flippable(SizedBoard<N>& board, const Disk disk, const bool passed, BitsFor<N>& stable)
+{
+    auto legal = board.legal_moves(disk);
+    if (!any(legal)) {
+        if (!passed) {
+            remove_flippable(board, opponent(disk), true, stable);
+        }
+        return;
+    }
+    while (any(legal)) {
+        const ScopedMove guard(board, disk, pop_lowest(legal));
+        stable &= ~guard.record().flipped;
+        remove_flippable(board, opponent(disk), false, stable);
+    }
+}
+
+TEST(features, mobility_matches_move_list)
+{
+    std::mt19937 random(3);
+    for (const size_t size : {4, 6, 8, 10}) {
+        Board board(size);
+        Disk disk = Disk::black;
+        while (true) {
+            const auto moves = board.possible_moves(disk);
+            const auto opponent_moves = board.possible_moves(opponent(disk));
+            board.visit([&](const auto& sized) {
+                constexpr size_t N = std::remove_cvref_t<decltype(sized)>::SIZE;
+                const auto own = sized.disks(disk);
+                const auto opp = sized.disks(opponent(disk));
+                EXPECT_EQ(Features<N>::mobility(own, opp), moves.size());
+                EXPECT_EQ(Features<N>::mobility(opp, own), opponent_moves.size());
+            });
+            if (moves.empty() && opponent_moves.empty()) {
+                break;
+            }
+            if (!moves.empty()) {
+                std::uniform_int_distribution<size_t> pick(0, moves.size() - 1);
+                board.place_disk(moves[pick(random)]);
+            }
+            disk = opponent(disk);
+        }
+    }
+}
+
+TEST(features, frontier_and_potential_mobility)
+{
+    for (unsigned seed = 0; seed < 20; ++seed) {
+        const auto board = random_sized_position<10>(60, seed);
+        const auto own = board.disks(Disk::black);
+        const auto opp = board.disks(Disk::white);
+        size_t frontier = 0;
+        size_t potential = 0;
+        for (size_t index = 0; index < 100; ++index) {
+            bool next_to_empty = false;
+            bool next_to_opp = false;
+            for (const size_t other : adjacent<10>(index)) {
+                next_to_empty = next_to_empty || board.get(other) == Disk::empty;
+                next_to_opp = next_to_opp || board.get(other) == Disk::white;
+            }
+            if (board.get(index) == Disk::black && next_to_empty) {
+                ++frontier;
+            }
+            if (board.get(index) == Disk::empty && next_to_opp) {
+                ++potential;
+            }
+        }
+        EXPECT_EQ(Features<10>::frontier(own, opp), frontier);
+        EXPECT_EQ(Features<10>::potential_mobility(own, opp), potential);
+    }
+}
+
+TEST(features, edge_stability)
+{
+    const auto& edges = EdgeStability<8>::instance();
+    // Run of disks from an own corner
+    EXPECT_EQ(edges.stable(0b00000111, 0b00001000), 0b00000111);
+    // Disk between empty squares can be flipped
+    EXPECT_EQ(edges.stable(0b00010000, 0), 0);
+    // Full edge is stable
+    EXPECT_EQ(edges.stable(0b10101010, 0b01010101), 0b10101010);
+    // Opponent corner disk does not protect own disks next to it
+    EXPECT_EQ(edges.stable(0b00000110, 0b00000001), 0);
+    // Run from an own corner stays stable when the opponent holds the other corner
+    EXPECT_EQ(edges.stable(0b11100000, 0b00000001), 0b11100000);
+}
+
+TEST(features, stable_disks_never_flip)
+{
+    for (unsigned seed = 0; seed < 100; ++seed) {
+        auto board = random_sized_position<4>(seed % 8, seed);
+        for (const Disk disk : {Disk::black, Disk::white}) {
+            const auto own = board.disks(disk);
+            const auto opp = board.disks(opponent(disk));
+            const auto stable = Features<4>::stable_disks(own, opp);
+            EXPECT_EQ(stable & ~own, 0U);
+            auto survivors = stable;
+            remove_flippable(board, Disk::black, false, survivors);
+            remove_flippable(board, Disk::white, false, survivors);
+            EXPECT_EQ(survivors, stable) << "seed " << seed;
+        }
+    }
+}
+
+TEST(features, stable_disks_full_board)
+{
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        const auto board = random_sized_position<9>(0, seed);
+        if (any(board.empty())) {
+            continue;
+        }
+        const auto own = board.disks(Disk::white);
+        EXPECT_EQ(Features<9>::stable_disks(own, board.disks(Disk::black)), own);
+    }
+    // Corners are always stable
+    const SizedBoard<6> board;
+    const auto corner = square_bit<BitsFor<6>>(0);
+    EXPECT_EQ(Features<6>::stable_disks(corner, board.disks(Disk::black)), corner);
+}
+
+}  // namespace othello
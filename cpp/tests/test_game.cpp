@@ -0,0 +1,94 @@
+#include "game.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <variant>
+
+namespace othello
+{
+TEST(game, legal_moves_and_apply)
+{
+    Game game(8);
+    EXPECT_EQ(game.side_to_move(), Disk::black);
+    const auto moves = game.legal_moves();
+    ASSERT_EQ(moves.size(), 4);
+    EXPECT_FALSE(game.over());
+
+    game.apply(moves[0]);
+    EXPECT_EQ(game.side_to_move(), Disk::white);
+    EXPECT_EQ(game.result().black, 4);
+    EXPECT_EQ(game.result().white, 1);
+
+    // Wrong side to move, occupied square and a square without flips are all illegal
+    EXPECT_THROW(game.apply(moves[1]), std::invalid_argument);
+    const Move occupied(moves[0].square, Disk::white, 0, {});
+    EXPECT_THROW(game.apply(occupied), std::invalid_argument);
+    const Move no_flips(Square(0, 0), Disk::white, 0, {});
+    EXPECT_THROW(game.apply(no_flips), std::invalid_argument);
+    const Move outside(Square(8, 0), Disk::white, 0, {});
+    EXPECT_THROW(game.apply(outside), std::invalid_argument);
+}
+
+TEST(game, computer_plays_to_the_end)
+{
+    SearchSettings settings;
+    settings.depth = 2;
+    settings.endgame = 6;
+    Computer black(Disk::black, settings, true);
+    Computer white(Disk::white, settings, true);
+    Game game(6);
+    EXPECT_THROW(static_cast<void>(game.step(white)), std::invalid_argument);
+
+    size_t passes = 0;
+    while (!game.over()) {
+        const Disk disk = game.side_to_move();
+        const Turn turn = game.step(disk == Disk::black ? black : white);
+        EXPECT_EQ(turn.disk, disk);
+        passes += turn.move.has_value() ? 0 : 1;
+    }
+    EXPECT_TRUE(game.legal_moves().empty());
+    const auto result = game.result();
+    EXPECT_EQ(result.margin(), static_cast<int>(result.black) - static_cast<int>(result.white));
+    EXPECT_EQ(result.winner(), game.board().result());
+    EXPECT_LE(result.black + result.white, 36);
+}
+
+TEST(game, computer_move_details)
+{
+    SearchSettings settings;
+    const Board board(6);
+    const auto moves = board.possible_moves(Disk::black);
+
+    // Test mode without a depth plays the first legal move
+    Computer first(Disk::black, settings, true);
+    const auto first_move = first.choose_move(board, moves);
+    EXPECT_EQ(first_move.move.square, moves[0].square);
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(first_move.details));
+
+    settings.depth = 3;
+    Computer searcher(Disk::black, settings, true);
+    const auto searched = searcher.choose_move(board, moves);
+    ASSERT_TRUE(std::holds_alternative<SearchResult>(searched.details));
+    EXPECT_EQ(std::get<SearchResult>(searched.details).depth, 3);
+
+    // The whole 4x4 game is within the endgame limit
+    settings.endgame = 16;
+    const Board small(4);
+    Computer solver(Disk::black, settings, true);
+    const auto solved = solver.choose_move(small, small.possible_moves(Disk::black));
+    EXPECT_TRUE(std::holds_alternative<SolveResult>(solved.details));
+
+    // A solve that does not finish in the move time falls back to a search
+    settings.depth = 0;
+    settings.move_time = 20;
+    settings.endgame = 64;
+    const Board large(8);
+    Computer timed(Disk::black, settings, false);
+    const auto fallback = timed.choose_move(large, large.possible_moves(Disk::black));
+    EXPECT_TRUE(std::holds_alternative<SearchResult>(fallback.details));
+    EXPECT_LT(timed.thinking_time(), std::chrono::seconds(2));
+}
+
+}  // namespace othello
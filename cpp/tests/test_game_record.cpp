@@ -0,0 +1,120 @@
+#include "game_record.hpp"
+#include "self_play.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace othello
+{
+class GameRecordTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const auto seed = ::testing::UnitTest::GetInstance()->random_seed();
+        path = std::filesystem::temp_directory_path()
+            / ("othello_record_test_" + std::to_string(seed) + ".games");
+        std::filesystem::remove(path);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    std::filesystem::path path;
+};
+
+TEST_F(GameRecordTest, log_matches_played_game)
+{
+    // Log the game the same way as the command line game does
+    SearchSettings settings;
+    settings.depth = 1;
+    Computer black(Disk::black, settings, true);
+    Computer white(Disk::white, settings, true);
+    Game game(6);
+    GameRecord record {6, 42, {}};
+    std::vector<std::string> log;
+    size_t passes = 0;
+    while (!game.over()) {
+        const Turn turn = game.step(game.side_to_move() == Disk::black ? black : white);
+        record.add(turn);
+        if (turn.move) {
+            log.push_back(fmt::format("{};{}", turn.move->log_entry(), game.board().log_entry()));
+        } else {
+            ++passes;
+        }
+    }
+    EXPECT_EQ(record.turns.size(), log.size() + passes);
+    EXPECT_EQ(record.log(), log);
+
+    GameLogReplay replay(record);
+    for (const auto& line : log) {
+        EXPECT_EQ(replay.next(), line);
+    }
+    EXPECT_FALSE(replay.next().has_value());
+
+    // A turn that is not a legal move is caught when replaying
+    record.turns.front() = 0;
+    EXPECT_THROW(static_cast<void>(record.log()), std::runtime_error);
+}
+
+TEST_F(GameRecordTest, write_and_read)
+{
+    std::vector<GameRecord> records;
+    Settings settings(4, true, true, false, false, true, false);
+    settings.search.depth = 1;
+    settings.search.endgame = 6;
+    for (uint64_t seed = 0; seed < 20; ++seed) {
+        settings.board_size = 4 + seed % 7;
+        records.push_back(play_game(settings, seed).record);
+    }
+    {
+        GameRecordWriter writer(path);
+        for (size_t index = 0; index < 10; ++index) {
+            writer.write(records[index]);
+        }
+    }
+    // Opening the file again appends after the existing records
+    GameRecordWriter writer(path);
+    for (size_t index = 10; index < records.size(); ++index) {
+        writer.write(records[index]);
+    }
+    writer.flush();
+    EXPECT_EQ(writer.size(), 10);
+
+    GameRecordReader reader(path);
+    std::vector<GameRecord> read;
+    while (auto record = reader.next()) {
+        read.push_back(std::move(*record));
+    }
+    EXPECT_EQ(read, records);
+    // One byte per turn after a small header
+    EXPECT_LT(std::filesystem::file_size(path), 20 * (11 + 100) + 16);
+}
+
+TEST_F(GameRecordTest, invalid_files)
+{
+    EXPECT_THROW(GameRecordReader("missing.games"), std::runtime_error);
+
+    std::ofstream(path, std::ios::binary) << "not a game record file";
+    EXPECT_THROW(GameRecordReader {path}, std::runtime_error);
+    EXPECT_THROW(GameRecordWriter {path}, std::runtime_error);
+    std::filesystem::remove(path);
+
+    {
+        GameRecordWriter writer(path);
+        writer.write(GameRecord {8, 1, {19, 18, 17}});
+    }
+    // Cut the last record short
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    GameRecordReader reader(path);
+    EXPECT_THROW(static_cast<void>(reader.next()), std::runtime_error);
+}
+
+}  // namespace othello
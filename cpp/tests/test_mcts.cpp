@@ -0,0 +1,110 @@
+#include "endgame.hpp"
+#include "mcts.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::ranges::find_if
+#include <random>
+
+namespace othello
+{
+/// Play random moves from the start until the given number of squares is left empty.
+Board random_position(const size_t size, const size_t empties, const unsigned seed, Disk& to_move)
+{
+    std::mt19937 random(seed);
+    Board board(size);
+    to_move = Disk::black;
+    while (board.empty_count() > empties) {
+        auto moves = board.possible_moves(to_move);
+        if (moves.empty()) {
+            to_move = opponent(to_move);
+            moves = board.possible_moves(to_move);
+            if (moves.empty()) {
+                break;
+            }
+        }
+        std::uniform_int_distribution<size_t> pick(0, moves.size() - 1);
+        board.place_disk(moves[pick(random)]);
+        to_move = opponent(to_move);
+    }
+    return board;
+}
+
+TEST(mcts, needs_limit)
+{
+    EXPECT_THROW(
+        static_cast<void>(monte_carlo_search(Board(8), Disk::black, MctsLimits {})),
+        std::invalid_argument
+    );
+}
+
+TEST(mcts, deterministic_with_seed)
+{
+    const Board board(8);
+    MctsLimits limits;
+    limits.playouts = 2000;
+    limits.seed = 42;
+    const auto first = monte_carlo_search(board, Disk::black, limits);
+    const auto second = monte_carlo_search(board, Disk::black, limits);
+    ASSERT_TRUE(first.best_move.has_value());
+    EXPECT_EQ(first.best_move, second.best_move);
+    EXPECT_EQ(first.win_rate, second.win_rate);
+    EXPECT_EQ(first.playouts, 2000);
+}
+
+TEST(mcts, parallel_playouts)
+{
+    const Board board(10);
+    MctsLimits limits;
+    limits.playouts = 4000;
+    limits.threads = 4;
+    const auto result = monte_carlo_search(board, Disk::black, limits);
+    ASSERT_TRUE(result.best_move.has_value());
+    EXPECT_EQ(result.playouts, 4000);
+    EXPECT_EQ(result.threads, 4);
+    EXPECT_GE(result.win_rate, 0.0);
+    EXPECT_LE(result.win_rate, 1.0);
+}
+
+TEST(mcts, no_legal_moves)
+{
+    const Board board = Board::from_position("B:WWWWWWWWWWWWWWW_");
+    MctsLimits limits;
+    limits.playouts = 10;
+    EXPECT_FALSE(monte_carlo_search(board, Disk::black, limits).best_move.has_value());
+}
+
+TEST(mcts, finds_winning_move)
+{
+    // Late positions where some moves win and others lose
+    TranspositionTable table(1);
+    int checked = 0;
+    for (unsigned seed = 0; seed < 200 && checked < 5; ++seed) {
+        Disk disk;
+        const Board board = random_position(6, 4, seed, disk);
+        const auto moves = board.possible_moves(disk);
+        bool has_loss = false;
+        for (const auto& move : moves) {
+            Board next = board;
+            next.place_disk(move);
+            has_loss |= solve_endgame(next, opponent(disk), table).score > 0;
+        }
+        if (!has_loss || solve_endgame(board, disk, table).score <= 0) {
+            continue;
+        }
+        ++checked;
+        MctsLimits limits;
+        limits.playouts = 20000;
+        const auto result = monte_carlo_search(board, disk, limits);
+        const auto chosen = std::ranges::find_if(moves, [&](const Move& move) {
+            return move.square == result.best_move;
+        });
+        ASSERT_NE(chosen, moves.end());
+        Board next = board;
+        next.place_disk(*chosen);
+        EXPECT_LT(solve_endgame(next, opponent(disk), table).score, 0) << "seed " << seed;
+    }
+    EXPECT_GT(checked, 0);
+}
+
+}  // namespace othello
@@ -148,4 +148,24 @@ TEST(move, log_entry)
     EXPECT_EQ(w.log_entry(), "W:(0,0),1");
 }
 
+TEST(move, affected_squares)
+{
+    const Move move(
+        Square {2, 2}, Disk::black, 3, {Direction(Step {-1, -1}, 1), Direction(Step {1, 0}, 2)}
+    );
+    EXPECT_EQ(move.directions.size(), 2);
+    const std::vector<Square> expected {{1, 1}, {3, 2}, {4, 2}};
+    EXPECT_EQ(move.affected_squares(), expected);
+}
+
+TEST(move, trivially_copyable)
+{
+    EXPECT_TRUE(std::is_trivially_copyable_v<Move>);
+    Move move(Square {0, 0}, Disk::white, 1, {Direction(Step {1, 0}, 1)});
+    const Move copy = move;
+    move.directions.emplace_back(Step {0, 1}, 2);
+    EXPECT_EQ(copy.directions.size(), 1);
+    EXPECT_EQ(move.directions.size(), 2);
+}
+
 }  // namespace othello
@@ -0,0 +1,130 @@
+#include "opening_book.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::ranges::any_of
+#include <cstdint>    // uint64_t
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace othello
+{
+class OpeningBookTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const auto seed = ::testing::UnitTest::GetInstance()->random_seed();
+        path = std::filesystem::temp_directory_path()
+            / ("othello_book_test_" + std::to_string(seed) + ".book");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    std::filesystem::path path;
+};
+
+TEST(opening_book, canonical_position_is_symmetric)
+{
+    // The four first moves on 8x8 are symmetric to each other
+    const Board start(8);
+    const auto moves = start.possible_moves(Disk::black);
+    ASSERT_EQ(moves.size(), 4);
+    std::vector<uint64_t> keys;
+    for (const auto& move : moves) {
+        Board board(8);
+        board.place_disk(move);
+        keys.push_back(canonical_position(board, Disk::white).key);
+        EXPECT_NE(canonical_position(board, Disk::black).key, keys.back());
+    }
+    for (const uint64_t key : keys) {
+        EXPECT_EQ(key, keys[0]);
+    }
+}
+
+TEST(opening_book, canonical_move_round_trip)
+{
+    const Board board(6);
+    for (unsigned symmetry = 0; symmetry < 8; ++symmetry) {
+        for (int y = 0; y < 6; ++y) {
+            for (int x = 0; x < 6; ++x) {
+                const Square square {x, y};
+                const size_t index = to_canonical_move(board, square, symmetry);
+                EXPECT_EQ(from_canonical_move(board, index, symmetry), square);
+            }
+        }
+    }
+}
+
+TEST_F(OpeningBookTest, write_and_lookup)
+{
+    // Book with the reply to one first move, written in the canonical orientation
+    Board board(8);
+    const auto first_moves = board.possible_moves(Disk::black);
+    board.place_disk(first_moves[0]);
+    const auto replies = board.possible_moves(Disk::white);
+    const auto [key, symmetry] = canonical_position(board, Disk::white);
+    const auto reply = replies.back().square;
+    OpeningBook::write(
+        path,
+        8,
+        {{key, 12, static_cast<uint8_t>(to_canonical_move(board, reply, symmetry)), 10},
+         {key, 5, 0, 4},
+         {key + 1, 0, 0, 1}}
+    );
+
+    const OpeningBook book(path);
+    EXPECT_EQ(book.size(), 2);
+    EXPECT_EQ(book.board_size(), 8);
+    const auto found = book.lookup(board, Disk::white);
+    ASSERT_TRUE(found.has_value());
+    // Deeper record wins for duplicate positions
+    EXPECT_EQ(found->square, reply);
+    EXPECT_EQ(found->score, 12);
+    EXPECT_EQ(found->depth, 10);
+
+    // Each symmetric variant gets the matching reply
+    for (const auto& move : first_moves) {
+        Board variant(8);
+        variant.place_disk(move);
+        const auto variant_move = book.lookup(variant, Disk::white);
+        ASSERT_TRUE(variant_move.has_value());
+        const auto variant_replies = variant.possible_moves(Disk::white);
+        EXPECT_TRUE(std::ranges::any_of(variant_replies, [&](const Move& candidate) {
+            return candidate.square == variant_move->square;
+        }));
+    }
+
+    EXPECT_FALSE(book.lookup(Board(8), Disk::black).has_value());
+    EXPECT_FALSE(book.lookup(Board(6), Disk::white).has_value());
+}
+
+TEST_F(OpeningBookTest, invalid_file)
+{
+    EXPECT_THROW(OpeningBook book(path), std::runtime_error);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not an opening book";
+    }
+    EXPECT_THROW(OpeningBook book(path), std::runtime_error);
+}
+
+TEST_F(OpeningBookTest, corrupt_record_count)
+{
+    OpeningBook::write(path, 8, {});
+    {
+        // Count that wraps the expected file size around to the size of the empty book
+        const uint64_t count = uint64_t {1} << 60;
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(16);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    EXPECT_THROW(OpeningBook book(path), std::runtime_error);
+}
+
+}  // namespace othello
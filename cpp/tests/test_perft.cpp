@@ -0,0 +1,59 @@
+#include "perft.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>  // uint64_t
+#include <stdexcept>
+
+namespace othello
+{
+/// Leaf count straight from the bitboards to check the `Board` move generation against.
+template<size_t N>
+uint64_t bitboard_perft(SizedBoard<N>& board, const Disk disk, const int depth)
+{
+    if (depth == 0) {
+        return 1;
+    }
+    auto legal = board.legal_moves(disk);
+    if (!any(legal)) {
+        if (!any(board.legal_moves(opponent(disk)))) {
+            return 1;
+        }
+        return bitboard_perft(board, opponent(disk), depth - 1);
+    }
+    uint64_t nodes = 0;
+    while (any(legal)) {
+        const ScopedMove guard(board, disk, pop_lowest(legal));
+        nodes += bitboard_perft(board, opponent(disk), depth - 1);
+    }
+    return nodes;
+}
+
+TEST(perft, start_position_8x8)
+{
+    constexpr std::array<uint64_t, 9> expected {1, 4, 12, 56, 244, 1396, 8200, 55092, 390216};
+    for (int depth = 0; depth < static_cast<int>(expected.size()); ++depth) {
+        EXPECT_EQ(perft(8, depth).nodes, expected[depth]) << "depth " << depth;
+    }
+}
+
+TEST(perft, whole_game_with_passes)
+{
+    // The 4x4 game tree is small enough to count to the end, through passes and early endings
+    SizedBoard<4> sized;
+    const uint64_t whole_game = bitboard_perft(sized, Disk::black, 20);
+    EXPECT_EQ(perft(4, 20).nodes, whole_game);
+    // Every leaf is a finished game, so going deeper adds nothing
+    EXPECT_EQ(perft(4, 24).nodes, whole_game);
+
+    Board board(6);
+    SizedBoard<6> sized6;
+    EXPECT_EQ(perft(board, 7), bitboard_perft(sized6, Disk::black, 7));
+    // The board is restored afterwards
+    EXPECT_EQ(board.position(), Board(6).position());
+
+    EXPECT_THROW(static_cast<void>(perft(8, -1)), std::invalid_argument);
+}
+
+}  // namespace othello
@@ -0,0 +1,144 @@
+#include "evaluation.hpp"
+#include "search.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::max, std::ranges::find_if
+#include <chrono>
+#include <type_traits>
+
+namespace othello
+{
+/// Plain minimax without pruning to check the search results against.
+template<size_t N>
+int minimax(SizedBoard<N>& board, const Disk disk, const int depth, const bool passed)
+{
+    auto legal = board.legal_moves(disk);
+    if (!any(legal)) {
+        if (passed) {
+            return final_score(board, disk);
+        }
+        return -minimax(board, opponent(disk), depth, true);
+    }
+    if (depth == 0) {
+        return evaluate(board, disk);
+    }
+    int best = -INFINITE_SCORE;
+    while (any(legal)) {
+        const ScopedMove guard(board, disk, pop_lowest(legal));
+        best = std::max(best, -minimax(board, opponent(disk), depth - 1, false));
+    }
+    return best;
+}
+
+TEST(search, matches_minimax)
+{
+    for (const int depth : {1, 2, 3, 4, 5}) {
+        const Board board(6);
+        TranspositionTable table(1);
+        const auto result = search(board, Disk::black, SearchLimits {depth}, table);
+        SizedBoard<6> sized;
+        EXPECT_EQ(result.score, minimax(sized, Disk::black, depth, false)) << "depth " << depth;
+        EXPECT_EQ(result.depth, depth);
+        EXPECT_GT(result.nodes, 0);
+    }
+}
+
+TEST(search, solves_small_board)
+{
+    // Depth covers the whole game on 4x4
+    const Board board(4);
+    TranspositionTable table(1);
+    const auto result = search(board, Disk::black, SearchLimits {MAX_SEARCH_DEPTH}, table);
+    SizedBoard<4> sized;
+    EXPECT_EQ(result.score, minimax(sized, Disk::black, MAX_SEARCH_DEPTH, false));
+    // White wins 4x4 with perfect play
+    EXPECT_LT(result.score, -WIN_SCORE);
+}
+
+TEST(search, returns_legal_move)
+{
+    Board board(8);
+    TranspositionTable table(1);
+    for (const Disk disk : {Disk::black, Disk::white, Disk::black, Disk::white}) {
+        const auto result = search(board, disk, SearchLimits {4}, table);
+        ASSERT_TRUE(result.best_move.has_value());
+        const auto moves = board.possible_moves(disk);
+        const auto found = std::ranges::find_if(moves, [&](const Move& move) {
+            return move.square == result.best_move;
+        });
+        ASSERT_NE(found, moves.end());
+        board.place_disk(*found);
+    }
+}
+
+TEST(search, stops_at_deadline)
+{
+    const Board board(10);
+    TranspositionTable table(1);
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = search(
+        board, Disk::black, SearchLimits {MAX_SEARCH_DEPTH, std::chrono::milliseconds {50}}, table
+    );
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(result.best_move.has_value());
+    EXPECT_GE(result.depth, 1);
+    EXPECT_LT(result.depth, MAX_SEARCH_DEPTH);
+    EXPECT_LT(elapsed, std::chrono::milliseconds {500});
+}
+
+TEST(search, zero_time_completes_first_depth)
+{
+    const Board board(8);
+    TranspositionTable table(1);
+    const auto result
+        = search(board, Disk::black, SearchLimits {10, std::chrono::milliseconds {0}}, table);
+    ASSERT_TRUE(result.best_move.has_value());
+    EXPECT_EQ(result.depth, 1);
+}
+
+TEST(search, parallel)
+{
+    const Board board(4);
+    TranspositionTable table(1);
+    const SearchLimits limits {MAX_SEARCH_DEPTH, std::nullopt, 4};
+    const auto result = search(board, Disk::black, limits, table);
+    ASSERT_TRUE(result.best_move.has_value());
+    EXPECT_EQ(result.threads, 4);
+    SizedBoard<4> sized;
+    EXPECT_EQ(result.score, minimax(sized, Disk::black, MAX_SEARCH_DEPTH, false));
+}
+
+TEST(search, parallel_stops_at_deadline)
+{
+    const Board board(10);
+    TranspositionTable table(1);
+    const SearchLimits limits {MAX_SEARCH_DEPTH, std::chrono::milliseconds {50}, 4};
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = search(board, Disk::black, limits, table);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds {500});
+    ASSERT_TRUE(result.best_move.has_value());
+    EXPECT_GT(result.nodes, 0);
+}
+
+TEST(search, takes_corner)
+{
+    // Black can take the top left corner
+    SizedBoard<8> sized(0, 0);
+    sized.set(1, Disk::white);
+    sized.set(2, Disk::black);
+    sized.set(27, Disk::black);
+    sized.set(28, Disk::white);
+    Board board(8);
+    board.visit([&](auto& inner) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(inner)>, SizedBoard<8>>) {
+            inner = sized;
+        }
+    });
+    TranspositionTable table(1);
+    const auto result = search(board, Disk::black, SearchLimits {3}, table);
+    ASSERT_TRUE(result.best_move.has_value());
+    EXPECT_EQ(*result.best_move, Square(0, 0));
+}
+
+}  // namespace othello
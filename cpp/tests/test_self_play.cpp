@@ -0,0 +1,158 @@
+#include "self_play.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::ranges::find_if
+#include <chrono>
+#include <cstdlib>    // std::abs
+#include <filesystem>
+#include <fstream>
+#include <iterator>  // std::istreambuf_iterator
+#include <stdexcept>
+#include <string>
+
+namespace othello
+{
+class SelfPlayTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        settings.game = Settings(6, true, true, false, false, true, false);
+        settings.game.search.depth = 2;
+        settings.game.search.endgame = 6;
+        settings.games = 40;
+        settings.seed = 7;
+    }
+
+    SelfPlaySettings settings;
+};
+
+TEST_F(SelfPlayTest, results_add_up)
+{
+    const auto result = self_play(settings);
+    EXPECT_EQ(result.games, settings.games);
+    EXPECT_EQ(result.black_wins + result.draws + result.white_wins, settings.games);
+    EXPECT_LE(std::abs(result.black_margin), result.margin);
+    EXPECT_GT(result.margin, 0);
+    // Random openings make the games differ
+    EXPECT_GT(result.black_wins, 0);
+    EXPECT_GT(result.white_wins, 0);
+}
+
+TEST_F(SelfPlayTest, same_games_with_any_thread_count)
+{
+    settings.threads = 1;
+    const auto single = self_play(settings);
+    settings.threads = 4;
+    const auto parallel = self_play(settings);
+    EXPECT_EQ(parallel.black_wins, single.black_wins);
+    EXPECT_EQ(parallel.draws, single.draws);
+    EXPECT_EQ(parallel.white_wins, single.white_wins);
+    EXPECT_EQ(parallel.black_margin, single.black_margin);
+    EXPECT_EQ(parallel.margin, single.margin);
+
+    // Each game is reproducible on its own
+    for (size_t game = 0; game < 5; ++game) {
+        const uint64_t seed = game_seed(settings.seed, game);
+        const auto played = play_game(settings.game, seed);
+        const auto again = play_game(settings.game, seed);
+        EXPECT_EQ(played.record, again.record);
+        EXPECT_EQ(played.result.margin(), again.result.margin());
+    }
+    EXPECT_NE(game_seed(settings.seed, 0), game_seed(settings.seed, 1));
+
+    settings.threads = 0;
+    EXPECT_THROW(static_cast<void>(self_play(settings)), std::invalid_argument);
+}
+
+TEST_F(SelfPlayTest, default_settings_are_reproducible)
+{
+    // Neither a depth nor a time limit
+    SelfPlaySettings defaults;
+    defaults.game = Settings(6, true, true, false, false, true, false);
+    defaults.games = 4;
+    defaults.threads = 2;
+    defaults.seed = 11;
+    const auto first = self_play(defaults);
+    const auto second = self_play(defaults);
+    EXPECT_EQ(first.games, defaults.games);
+    EXPECT_EQ(second.black_wins, first.black_wins);
+    EXPECT_EQ(second.draws, first.draws);
+    EXPECT_EQ(second.white_wins, first.white_wins);
+    EXPECT_EQ(second.black_margin, first.black_margin);
+    EXPECT_EQ(second.margin, first.margin);
+    // Searching to the default depth and not by time, so the games take no time to think
+    EXPECT_LT(first.elapsed, std::chrono::seconds(5));
+
+    defaults.game.search.engine = Engine::mcts;
+    EXPECT_THROW(static_cast<void>(self_play(defaults)), std::invalid_argument);
+}
+
+TEST_F(SelfPlayTest, records_in_game_order)
+{
+    const auto seed = std::to_string(::testing::UnitTest::GetInstance()->random_seed());
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto single_path = directory / ("othello_self_play_test_" + seed + "_1.games");
+    const auto parallel_path = directory / ("othello_self_play_test_" + seed + "_4.games");
+    std::filesystem::remove(single_path);
+    std::filesystem::remove(parallel_path);
+
+    settings.threads = 1;
+    settings.record = single_path;
+    static_cast<void>(self_play(settings));
+    settings.threads = 4;
+    settings.record = parallel_path;
+    static_cast<void>(self_play(settings));
+
+    const auto read_file = [](const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), {});
+    };
+    const auto single = read_file(single_path);
+    EXPECT_FALSE(single.empty());
+    EXPECT_EQ(read_file(parallel_path), single);
+
+    GameRecordReader reader(single_path);
+    for (size_t game = 0; game < settings.games; ++game) {
+        const auto record = reader.next();
+        ASSERT_TRUE(record.has_value());
+        EXPECT_EQ(record->seed, game_seed(settings.seed, game));
+    }
+    std::filesystem::remove(single_path);
+    std::filesystem::remove(parallel_path);
+}
+
+TEST_F(SelfPlayTest, plays_by_time_without_depth)
+{
+    settings.game.search.depth = 0;
+    settings.game.search.move_time = 5;
+    const auto played = play_game(settings.game, game_seed(settings.seed, 0));
+
+    // Replay the game to check that the computer searched instead of playing its first move
+    Game game(6);
+    size_t computer_moves = 0;
+    size_t first_moves = 0;
+    for (size_t turn = 0; turn < played.record.turns.size(); ++turn) {
+        const uint8_t index = played.record.turns[turn];
+        if (index == GameRecord::PASS) {
+            game.pass();
+            continue;
+        }
+        const Square square(index % 6, index / 6);
+        const auto moves = game.legal_moves();
+        const auto move = std::ranges::find_if(moves, [&](const Move& candidate) {
+            return candidate.square == square;
+        });
+        ASSERT_NE(move, moves.end());
+        if (turn >= SELF_PLAY_RANDOM_MOVES) {
+            ++computer_moves;
+            first_moves += move == moves.begin() ? 1 : 0;
+        }
+        game.apply(*move);
+    }
+    EXPECT_TRUE(game.over());
+    EXPECT_LT(first_moves, computer_moves);
+}
+
+}  // namespace othello
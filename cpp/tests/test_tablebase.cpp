@@ -0,0 +1,131 @@
+#include "endgame.hpp"
+#include "tablebase.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::ranges::find_if
+#include <array>
+#include <cstdint>  // uint64_t
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace othello
+{
+/// Play random moves from the start until the given number of squares is left empty.
+Board random_game_position(const size_t size, const size_t empties, std::mt19937& random)
+{
+    Board board(size);
+    Disk disk = Disk::black;
+    while (board.empty_count() > empties && board.can_play()) {
+        auto moves = board.possible_moves(disk);
+        if (!moves.empty()) {
+            std::uniform_int_distribution<size_t> pick(0, moves.size() - 1);
+            board.place_disk(moves[pick(random)]);
+        }
+        disk = opponent(disk);
+    }
+    if (board.side_to_move() != disk) {
+        board.pass();
+    }
+    return board;
+}
+
+/// Check the tablebase result against the endgame solver for every position of random games.
+template<typename Table>
+void expect_perfect_play(const Table& table, const size_t size, const size_t empties)
+{
+    std::mt19937 random(7);
+    TranspositionTable transpositions;
+    for (int game = 0; game < 10; ++game) {
+        Board board = random_game_position(size, empties, random);
+        while (true) {
+            Disk disk = board.side_to_move();
+            if (board.possible_moves(disk).empty()) {
+                if (board.possible_moves(opponent(disk)).empty()) {
+                    break;
+                }
+                board.pass();
+                disk = opponent(disk);
+            }
+            const auto found = table.lookup(board, disk);
+            ASSERT_TRUE(found.has_value()) << board.position();
+            const auto solved = solve_endgame(board, disk, transpositions);
+            EXPECT_EQ(found->score, solved.score) << board.position();
+            // The tablebase move keeps the result
+            const auto moves = board.possible_moves(disk);
+            const auto move = std::ranges::find_if(moves, [&](const Move& candidate) {
+                return candidate.square == found->square;
+            });
+            ASSERT_NE(move, moves.end()) << board.position();
+            board.place_disk(*move);
+            const int score = solve_endgame(board, opponent(disk), transpositions).score;
+            EXPECT_EQ(-score, solved.score) << board.position();
+        }
+    }
+}
+
+TEST(tablebase, whole_game_4x4)
+{
+    TablebaseGenerator generator(TablebaseSettings {4, 0, 0, 0, false});
+    generator.generate();
+    EXPECT_GT(generator.size(), 0);
+    expect_perfect_play(generator, 4, 12);
+    EXPECT_FALSE(generator.lookup(Board(6), Disk::black).has_value());
+}
+
+TEST(tablebase, positions_with_few_empties)
+{
+    TablebaseGenerator generator(TablebaseSettings {6, 8, 0, 0, false});
+    std::mt19937 random(7);
+    for (int game = 0; game < 10; ++game) {
+        generator.add(random_game_position(6, 8, random));
+    }
+    expect_perfect_play(generator, 6, 8);
+    // Random games reach positions with at most the given number of empty squares
+    TablebaseGenerator sampled(TablebaseSettings {6, 6, 5, 1, false});
+    sampled.generate();
+    EXPECT_GT(sampled.size(), 0);
+    EXPECT_THROW(sampled.add(Board(4)), std::invalid_argument);
+}
+
+TEST(tablebase, slots_compare_the_full_key)
+{
+    std::vector<TablebaseSlot> slots(16);
+    const uint64_t key = 0x123456789ABC0001;
+    slots[TablebaseSlot::find(slots, key)] = {key, 5, 3, 1};
+    EXPECT_EQ(slots[TablebaseSlot::find(slots, key)].key, key);
+
+    // Keys that share the upper 48 bits, or the bits that pick the slot, are different positions
+    for (const uint64_t other : std::array<uint64_t, 2> {0x123456789ABC0002, 0xFEDCBA9876540001}) {
+        const auto& slot = slots[TablebaseSlot::find(slots, other)];
+        EXPECT_EQ(slot.occupied, 0) << other;
+    }
+}
+
+TEST(tablebase, write_and_read)
+{
+    const auto path = std::filesystem::temp_directory_path()
+        / ("othello_tablebase_test_"
+           + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".tablebase");
+    TablebaseGenerator generator(TablebaseSettings {4, 0, 0, 0, false});
+    generator.generate();
+    generator.write(path);
+    {
+        const Tablebase tablebase(path);
+        EXPECT_EQ(tablebase.size(), generator.size());
+        EXPECT_EQ(tablebase.board_size(), 4);
+        expect_perfect_play(tablebase, 4, 12);
+    }
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "not a tablebase";
+    }
+    EXPECT_THROW(Tablebase tablebase(path), std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(Tablebase tablebase(path), std::runtime_error);
+}
+
+}  // namespace othello
@@ -0,0 +1,89 @@
+#include "transposition_table.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace othello
+{
+TEST(transposition_table, size)
+{
+    const TranspositionTable table(1);
+    EXPECT_EQ(table.size(), 1024 * 1024 / 16);
+}
+
+TEST(transposition_table, store_and_probe)
+{
+    TranspositionTable table(1);
+    const uint64_t hash = 0x1234'5678'9ABC'DEF0;
+    EXPECT_FALSE(table.probe(hash).has_value());
+
+    const TableEntry entry {-42, 7, Bound::lower, 19};
+    table.store(hash, entry);
+    const auto found = table.probe(hash);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(*found, entry);
+
+    // Same slot but a different position
+    EXPECT_FALSE(table.probe(hash ^ (uint64_t {1} << 63)).has_value());
+
+    table.clear();
+    EXPECT_FALSE(table.probe(hash).has_value());
+}
+
+TEST(transposition_table, replacement)
+{
+    TranspositionTable table(1);
+    const uint64_t first = 5;
+    const uint64_t second = first + (uint64_t {1} << 40);
+
+    table.store(first, {10, 8, Bound::exact, 3});
+    // Shallower result for another position does not replace a deeper one from this search
+    table.store(second, {20, 2, Bound::exact, 4});
+    EXPECT_TRUE(table.probe(first).has_value());
+    EXPECT_FALSE(table.probe(second).has_value());
+
+    // Same position is always replaced
+    table.store(first, {-10, 1, Bound::upper, TableEntry::NO_MOVE});
+    EXPECT_EQ(table.probe(first)->score, -10);
+
+    // Entries from an earlier search are replaced
+    table.store(first, {10, 8, Bound::exact, 3});
+    table.new_search();
+    table.store(second, {20, 2, Bound::exact, 4});
+    EXPECT_FALSE(table.probe(first).has_value());
+    EXPECT_EQ(table.probe(second)->score, 20);
+}
+
+TEST(transposition_table, concurrent_access)
+{
+    TranspositionTable table(1);
+    // Many threads write different positions to a few slots.
+    // A lookup must never return an entry that was stored for another position.
+    constexpr int threads = 4;
+    constexpr uint64_t positions = 20000;
+    std::vector<std::thread> workers;
+    std::atomic<int> errors {0};
+    for (int thread = 0; thread < threads; ++thread) {
+        workers.emplace_back([&table, &errors, thread] {
+            for (uint64_t i = 0; i < positions; ++i) {
+                const uint64_t hash = (i << 32) | (i % 16);
+                const auto score = static_cast<int16_t>(i % 1000);
+                table.store(hash, {score, static_cast<uint8_t>(thread), Bound::exact, 0});
+                if (const auto found = table.probe(hash)) {
+                    if (found->score != score) {
+                        ++errors;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(errors, 0);
+}
+
+}  // namespace othello
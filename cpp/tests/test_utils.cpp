@@ -2,7 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <string>
+#include <vector>
 
 namespace othello
 {
@@ -42,4 +44,42 @@ TEST(calculate_sha256, full_log)
         "ad4679949110ed7997aa1bf09441a7eb491b498189c03685ffdd6ddbb70e3c22"
     );
 }
+
+TEST(sha256, incremental_matches_one_shot)
+{
+    const std::vector<std::string> lines {
+        "01: B:(0,1),1;____BBB__BW_____",
+        "02: W:(0,0),1;W___BWB__BW_____",
+        "03: B:(1,0),1;WB__BBB__BW_____",
+    };
+    std::string text;
+    Sha256 hash;
+    for (const auto& line : lines) {
+        if (!text.empty()) {
+            text += "\n";
+            hash.update("\n");
+        }
+        text += line;
+        hash.update(line);
+        EXPECT_EQ(hash.hex_digest(), calculate_sha256(text));
+    }
+}
+
+TEST(sha256, reset)
+{
+    Sha256 hash;
+    hash.update("something else");
+    hash.reset();
+    hash.update("test");
+    EXPECT_EQ(
+        hash.hex_digest(), "9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08"
+    );
+}
+
+TEST(to_hex, bytes)
+{
+    constexpr std::array<unsigned char, 5> bytes {0x00, 0x0F, 0xA0, 0x7E, 0xFF};
+    EXPECT_EQ(to_hex(bytes), "000fa07eff");
+    EXPECT_EQ(to_hex({}), "");
+}
 }  // namespace othello